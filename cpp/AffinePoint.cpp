@@ -0,0 +1,53 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include "AffinePoint.hpp"
+#include "CountOps.hpp"
+
+using std::uint32_t;
+
+
+AffinePoint::AffinePoint() :
+	x(Uint256::ZERO), y(Uint256::ZERO) {}
+
+
+AffinePoint::AffinePoint(const FieldInt &x_, const FieldInt &y_) :
+	x(x_), y(y_) {}
+
+
+void AffinePoint::negate(uint32_t enable) {
+	assert((enable >> 1) == 0);
+	countOps(functionOps);
+	FieldInt negY(Uint256::ZERO);
+	negY.subtract(y);  // Zero stays zero
+	y.replace(negY, enable);
+	countOps(1 * fieldintCopyOps);
+}
+
+
+void AffinePoint::replace(const AffinePoint &other, uint32_t enable) {
+	assert((enable >> 1) == 0);
+	countOps(functionOps);
+	x.replace(other.x, enable);
+	y.replace(other.y, enable);
+}
+
+
+bool AffinePoint::isZero() const {
+	countOps(functionOps);
+	countOps(1 * arithmeticOps);
+	const FieldInt zero(Uint256::ZERO);
+	return (x == zero) & (y == zero);
+}
+
+
+// Static initializers
+const AffinePoint AffinePoint::ZERO(
+	FieldInt("0000000000000000000000000000000000000000000000000000000000000000"),
+	FieldInt("0000000000000000000000000000000000000000000000000000000000000000"));
@@ -0,0 +1,61 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "FieldInt.hpp"
+
+
+/* 
+ * A point on the secp256k1 elliptic curve in plain affine coordinates (x, y), as stored in the precomputed
+ * tables of the scalar multiplication paths. Adding an affine point to a JacobianPoint is cheaper than adding
+ * a general one, because its implicit z coordinate is 1. The point at infinity is represented by (0, 0),
+ * which is not on the curve. Instances of this class are mutable.
+ */
+class AffinePoint final {
+	
+	/*---- Fields ----*/
+	
+	public: FieldInt x;
+	public: FieldInt y;
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Constructs the point at infinity. Constant-time.
+	public: explicit AffinePoint();
+	
+	
+	// Constructs a point from the given coordinates. Constant-time with respect to the values.
+	public: explicit AffinePoint(const FieldInt &x_, const FieldInt &y_);
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Negates this point (y becomes -y) if enable is 1, or does nothing if enable is 0.
+	// The point at infinity is unchanged. Constant-time with respect to both values.
+	public: void negate(std::uint32_t enable=1);
+	
+	
+	// Copies the given point into this point if enable is 1, or does nothing if enable is 0.
+	// Constant-time with respect to both values and the enable.
+	public: void replace(const AffinePoint &other, std::uint32_t enable);
+	
+	
+	// Tests whether this point is the point at infinity. Constant-time with respect to this value.
+	public: bool isZero() const;
+	
+	
+	/*---- Class constants ----*/
+	
+	public: static const AffinePoint ZERO;  // Point at infinity, (0, 0)
+	
+};
@@ -6,10 +6,21 @@
  * https://github.com/nayuki/Bitcoin-Cryptography-Library
  */
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <thread>
 #include "CountOps.hpp"
 #include "CurvePoint.hpp"
+#include "JacobianPoint.hpp"
+#include "Keccak256.hpp"
+#include "MultiplySumScratch.hpp"
+#include "PublicScalar.hpp"
 
+using std::int8_t;
+using std::int16_t;
 using std::uint8_t;
 using std::uint32_t;
 
@@ -30,91 +41,82 @@ void CurvePoint::add(const CurvePoint &other) {
 	countOps(functionOps);
 	
 	/* 
-	 * (See https://www.nayuki.io/page/elliptic-curve-point-addition-in-projective-coordinates)
+	 * Complete addition for a = 0 (Renes, Costello, Batina, "Complete addition formulas for prime
+	 * order elliptic curves", 2015, algorithm 7). The same formulas give the right answer when either
+	 * point is zero, when the points are equal, and when they are opposite, so there are no special cases.
 	 * Algorithm pseudocode:
-	 * if (this == ZERO)
-	 *   this = other
-	 * else if (other == ZERO)
-	 *   this = this
-	 * else {
-	 *   t0 = y0 * z1
-	 *   t1 = y1 * z0
-	 *   u0 = x0 * z1
-	 *   u1 = x1 * z0
-	 *   if (u0 == u1) {  // Same x coordinates
-	 *     if (t0 == t1)  // Same y coordinates
-	 *       this = twice()
-	 *     else
-	 *       this = ZERO
-	 *   } else {
-	 *     t = t0 - t1
-	 *     u = u0 - u1
-	 *     u2 = u^2
-	 *     v = z0 * z1
-	 *     w = t^2 * v - u2 * (u0 + u1)
-	 *     x' = u * w
-	 *     u3 = u2 * u
-	 *     y' = t * (u0 * u2 - w) - t0 * u3
-	 *     z' = u3 * v
-	 *   }
-	 * }
+	 * t0 = x0 * x1
+	 * t1 = y0 * y1
+	 * t2 = z0 * z1
+	 * t3 = (x0 + y0) * (x1 + y1) - t0 - t1  // x0 * y1 + x1 * y0
+	 * t4 = (y0 + z0) * (y1 + z1) - t1 - t2  // y0 * z1 + y1 * z0
+	 * t5 = (x0 + z0) * (x1 + z1) - t0 - t2  // x0 * z1 + x1 * z0
+	 * t0 = 3 * t0
+	 * t2 = 3b * t2
+	 * t5 = 3b * t5
+	 * x' = t3 * (t1 - t2) - t4 * t5
+	 * y' = (t1 + t2) * (t1 - t2) + t0 * t5
+	 * z' = t4 * (t1 + t2) + t0 * t3
 	 */
-	bool thisZero  = this->isZero();
-	bool otherZero = other.isZero();
-	CurvePoint temp = *this;
-	temp.twice();
-	temp.replace(*this, static_cast<uint32_t>(otherZero));
-	temp.replace(other, static_cast<uint32_t>(thisZero ));
-	
-	FieldInt u0 = this->x;
-	FieldInt u1 = other.x;
-	FieldInt t0 = this->y;
-	FieldInt &t1 = x;  // Reuse memory
-	t1 = other.y;
-	u0.multiply(other.z);
-	u1.multiply(this->z);
-	t0.multiply(other.z);
-	t1.multiply(this->z);
-	bool sameX = u0 == u1;
-	bool sameY = t0 == t1;
-	temp.replace(ZERO, static_cast<uint32_t>(!thisZero & !otherZero & sameX & !sameY));
-	
-	FieldInt &t = y;  // Reuse memory
-	t = t0;
-	t.subtract(t1);
-	FieldInt u = u0;
-	u.subtract(u1);
-	FieldInt u2 = u;
-	u2.square();
-	FieldInt &v = z;  // Reuse memory
-	v.multiply(other.z);
-	
-	FieldInt w = t;
-	w.square();
-	w.multiply(v);
-	u1.add(u0);
-	u1.multiply(u2);
-	w.subtract(u1);
+	FieldInt t0 = x;
+	t0.multiply(other.x);
+	FieldInt t1 = y;
+	t1.multiply(other.y);
+	FieldInt t2 = z;
+	t2.multiply(other.z);
 	
-	x = u;
-	x.multiply(w);
+	FieldInt t3 = x;
+	t3.add(y);
+	FieldInt t4 = other.x;
+	t4.add(other.y);
+	t3.multiply(t4);
+	t4 = t0;
+	t4.add(t1);
+	t3.subtract(t4);
 	
-	FieldInt &u3 = u1;  // Reuse memory
-	u3 = u;
-	u3.multiply(u2);
+	FieldInt t5 = other.y;
+	t5.add(other.z);
+	t4 = y;
+	t4.add(z);
+	t4.multiply(t5);
+	t5 = t1;
+	t5.add(t2);
+	t4.subtract(t5);
 	
-	u0.multiply(u2);
-	u0.subtract(w);
-	t.multiply(u0);
-	t0.multiply(u3);
-	t.subtract(t0);  // Assigns to y
+	FieldInt t6 = other.x;
+	t6.add(other.z);
+	t5 = x;
+	t5.add(z);
+	t5.multiply(t6);
+	t6 = t0;
+	t6.add(t2);
+	t5.subtract(t6);
 	
-	v.multiply(u3);  // Assigns to z
+	t6 = t0;
+	t6.multiply2();
+	t0.add(t6);
+	multiplyB3(t2);
+	multiplyB3(t5);
 	
-	this->replace(temp, static_cast<uint32_t>(thisZero | otherZero | sameX));
-	countOps(8 * arithmeticOps);
-	countOps(10 * fieldintCopyOps);
-	countOps(1 * curvepointCopyOps);
+	// Only assign to this point's fields now, in case other aliases this
+	FieldInt &sum = t6;  // Reuse memory
+	sum = t1;
+	sum.add(t2);
+	t1.subtract(t2);
+	x = t3;
+	x.multiply(t1);
+	t2 = t4;
+	t2.multiply(t5);
+	x.subtract(t2);
+	y = sum;
+	y.multiply(t1);
+	t5.multiply(t0);
+	y.add(t5);
+	z = sum;
+	z.multiply(t4);
+	t0.multiply(t3);
+	z.add(t0);
+	countOps(25 * fieldintCopyOps);
 }
 
 
@@ -122,107 +124,155 @@ void CurvePoint::twice() {
 	countOps(functionOps);
 	
 	/* 
-	 * (See https://www.nayuki.io/page/elliptic-curve-point-addition-in-projective-coordinates)
+	 * Complete doubling for a = 0 (Renes, Costello, Batina, algorithm 9). The point at infinity
+	 * needs no special case, and no point on this curve has y = 0.
 	 * Algorithm pseudocode:
-	 * if (this == ZERO || y == 0)
-	 *   this = ZERO
-	 * else {
-	 *   a = 0 (curve parameter)
-	 *   t = 3 * x^2 + a * z^2
-	 *   u = 2 * y * z
-	 *   v = 2 * u * x * y
-	 *   w = t^2 - 2 * v
-	 *   x' = u * w
-	 *   y' = t * (v - w) - 2 * (u * y)^2
-	 *   z' = u^3
-	 * }
+	 * t0 = y^2
+	 * t1 = 3b * z^2
+	 * t2 = t0 - 3 * t1
+	 * x' = 2 * t2 * x * y
+	 * y' = t2 * (t0 + t1) + 8 * t0 * t1
+	 * z' = 8 * t0 * y * z
 	 */
+	FieldInt t0 = y;
+	t0.square();
+	FieldInt t1 = z;
+	t1.square();
+	multiplyB3(t1);
+	FieldInt t2 = t1;
+	t2.multiply2();
+	t2.add(t1);
+	FieldInt t3 = t0;
+	t3.subtract(t2);
 	
-	bool zeroResult = isZero() | (y == FI_ZERO);
-	countOps(1 * arithmeticOps);
-	
-	FieldInt u = y;
-	u.multiply(z);
-	u.multiply2();
+	z.multiply(y);
+	z.multiply(t0);
+	z.multiply2();
+	z.multiply2();
+	z.multiply2();
 	
-	FieldInt v = u;
-	v.multiply(x);
-	v.multiply(y);
-	v.multiply2();
+	x.multiply(y);
+	x.multiply(t3);
+	x.multiply2();
 	
-	x.square();
-	FieldInt t = x;
-	t.multiply2();
-	t.add(x);
+	y = t0;
+	y.add(t1);
+	y.multiply(t3);
+	t0.multiply(t1);
+	t0.multiply2();
+	t0.multiply2();
+	t0.multiply2();
+	y.add(t0);
+	countOps(5 * fieldintCopyOps);
+}
+
+
+void CurvePoint::addMixed(const AffinePoint &other) {
+	countOps(functionOps);
 	
-	FieldInt &w = z;  // Reuse memory
-	w = t;
-	w.square();
-	x = v;
-	x.multiply2();
-	w.subtract(x);
+	/* 
+	 * Complete mixed addition for a = 0 (Renes, Costello, Batina, algorithm 8), which is add() with
+	 * z1 = 1. The formulas do not cover other being zero, so that case is selected at the end.
+	 * Algorithm pseudocode:
+	 * t0 = 3 * x0 * x1
+	 * t1 = y0 * y1
+	 * t2 = 3b * z0
+	 * t3 = (x0 + y0) * (x1 + y1) - x0 * x1 - t1  // x0 * y1 + x1 * y0
+	 * t4 = y1 * z0 + y0
+	 * t5 = 3b * (x1 * z0 + x0)
+	 * x' = t3 * (t1 - t2) - t4 * t5
+	 * y' = (t1 + t2) * (t1 - t2) + t0 * t5
+	 * z' = t4 * (t1 + t2) + t0 * t3
+	 */
+	FieldInt t0 = x;
+	t0.multiply(other.x);
+	FieldInt t1 = y;
+	t1.multiply(other.y);
+	FieldInt t2 = z;
+	multiplyB3(t2);
 	
-	x = v;
-	x.subtract(w);
-	x.multiply(t);
-	y.multiply(u);
-	y.square();
-	y.multiply2();
-	x.subtract(y);
-	y = x;
+	FieldInt t3 = x;
+	t3.add(y);
+	FieldInt t4 = other.x;
+	t4.add(other.y);
+	t3.multiply(t4);
+	t4 = t0;
+	t4.add(t1);
+	t3.subtract(t4);
 	
-	x = u;
-	x.multiply(w);
+	t4 = other.y;
+	t4.multiply(z);
+	t4.add(y);
+	FieldInt t5 = other.x;
+	t5.multiply(z);
+	t5.add(x);
+	multiplyB3(t5);
 	
-	z = u;
-	z.square();
-	z.multiply(u);
+	FieldInt t6 = t0;
+	t6.multiply2();
+	t0.add(t6);
 	
-	this->replace(ZERO, static_cast<uint32_t>(zeroResult));
-	countOps(10 * fieldintCopyOps);
+	FieldInt &sum = t6;  // Reuse memory
+	sum = t1;
+	sum.add(t2);
+	t1.subtract(t2);
+	uint32_t enable = static_cast<uint32_t>(!other.isZero());
+	FieldInt newX = t3;
+	newX.multiply(t1);
+	t2 = t4;
+	t2.multiply(t5);
+	newX.subtract(t2);
+	x.replace(newX, enable);
+	FieldInt newY = sum;
+	newY.multiply(t1);
+	t5.multiply(t0);
+	newY.add(t5);
+	y.replace(newY, enable);
+	sum.multiply(t4);
+	t0.multiply(t3);
+	sum.add(t0);
+	z.replace(sum, enable);
+	countOps(1 * arithmeticOps);
+	countOps(20 * fieldintCopyOps);
 }
 
 
 void CurvePoint::multiply(const Uint256 &n) {
-	// Precompute [this*0, this*1, ..., this*15]
-	countOps(functionOps);
-	constexpr int tableBits = 4;  // Do not modify
-	constexpr int tableLen = 1 << tableBits;
-	CurvePoint table[tableLen];  // Default-initialized with ZERO
-	table[1] = *this;
-	table[2] = *this;
-	countOps(18 * curvepointCopyOps);
-	table[2].twice();
-	for (int i = 3; i < tableLen; i++) {
-		countOps(loopBodyOps);
-		table[i] = table[i - 1];
-		table[i].add(*this);
-		countOps(2 * arithmeticOps);
-		countOps(1 * curvepointCopyOps);
-	}
+	/* 
+	 * GLV method: split n = k1 + k2 * lambda (mod order) where |k1|, |k2| < 2^128, then
+	 * compute n * P = k1 * P + k2 * (lambda * P) with a shared chain of only 128 doublings.
+	 * The table for lambda * P is the table for P with every x-coordinate multiplied by beta.
+	 */
+	countOps(functionOps);
+	Scalar r1(Uint256::ZERO), r2(Uint256::ZERO);
+	Scalar::splitLambda(Scalar(n), r1, r2);
+	Uint256 k1, k2;
+	uint32_t neg1 = toMagnitude(r1, k1);
+	uint32_t neg2 = toMagnitude(r2, k2);
+	countOps(4 * uint256CopyOps);
 	
-	// Process tableBits per iteration (windowed method)
-	*this = ZERO;
-	countOps(1 * curvepointCopyOps);
-	for (int i = Uint256::NUM_WORDS * 32 - tableBits; i >= 0; i -= tableBits) {
+	AffinePoint tableP[TABLE_LEN];
+	AffinePoint tableQ[TABLE_LEN];
+	CurvePoint p = *this;
+	p.negate(neg1);
+	makeTable(p, tableP);
+	for (int i = 0; i < TABLE_LEN; i++) {
 		countOps(loopBodyOps);
-		unsigned int inc = (n.value[i >> 5] >> (i & 31)) & (tableLen - 1);
-		CurvePoint q = ZERO;  // Dummy initial value
-		countOps(5 * arithmeticOps);
-		countOps(1 * curvepointCopyOps);
-		for (unsigned int j = 0; j < tableLen; j++) {
-			countOps(loopBodyOps);
-			q.replace(table[j], static_cast<uint32_t>(j == inc));
-			countOps(1 * arithmeticOps);
-		}
-		this->add(q);
-		if (i != 0) {
-			for (int j = 0; j < tableBits; j++) {
-				countOps(loopBodyOps);
-				this->twice();
-			}
-		}
+		tableQ[i] = tableP[i];
+		tableQ[i].x.multiply(BETA);
+		tableQ[i].negate(neg1 ^ neg2);
+		countOps(1 * arithmeticOps);
+		countOps(2 * fieldintCopyOps);
 	}
+	*this = multiplyAddTables(k1, tableP, k2, tableQ, 128);
+	countOps(2 * curvepointCopyOps);
+}
+
+
+void CurvePoint::multiplyVar(const PublicScalar &n) {
+	countOps(functionOps);
+	*this = multiplySumVar(&n, this, 1);
+	countOps(1 * curvepointCopyOps);
 }
 
 
@@ -253,6 +303,31 @@ void CurvePoint::normalize() {
 }
 
 
+void CurvePoint::normalizeVar() {
+	countOps(functionOps);
+	if (z != FI_ZERO) {
+		z.reciprocalVar();
+		x.multiply(z);
+		y.multiply(z);
+		z = FI_ONE;
+		countOps(1 * fieldintCopyOps);
+	} else {
+		x.replace(FI_ONE, static_cast<uint32_t>(x != FI_ZERO));
+		y.replace(FI_ONE, static_cast<uint32_t>(y != FI_ZERO));
+	}
+}
+
+
+void CurvePoint::negate(uint32_t enable) {
+	assert((enable >> 1) == 0);
+	countOps(functionOps);
+	FieldInt negY = FI_ZERO;
+	negY.subtract(y);
+	y.replace(negY, enable);
+	countOps(1 * fieldintCopyOps);
+}
+
+
 void CurvePoint::replace(const CurvePoint &other, uint32_t enable) {
 	assert((enable >> 1) == 0);
 	countOps(functionOps);
@@ -304,21 +379,762 @@ void CurvePoint::toCompressedPoint(uint8_t output[33]) const {
 }
 
 
+void CurvePoint::toEthereumAddress(uint8_t output[20]) const {
+	assert(output != nullptr);
+	uint8_t coords[FieldInt::NUM_WORDS * 4 * 2];
+	x.getBigEndianBytes(&coords[0]);
+	y.getBigEndianBytes(&coords[FieldInt::NUM_WORDS * 4]);
+	uint8_t hash[Keccak256::HASH_LEN];
+	Keccak256::getHash(coords, sizeof(coords), hash);
+	std::copy(&hash[Keccak256::HASH_LEN - 20], &hash[Keccak256::HASH_LEN], output);
+}
+
+
+CurvePoint CurvePoint::multiplyAdd(const Uint256 &u1, const CurvePoint &p, const Uint256 &u2, const CurvePoint &q) {
+	countOps(functionOps);
+	AffinePoint tableP[TABLE_LEN];
+	AffinePoint tableQ[TABLE_LEN];
+	makeTable(p, tableP);
+	makeTable(q, tableQ);
+	return multiplyAddTables(u1, tableP, u2, tableQ, Uint256::NUM_WORDS * 32);
+}
+
+
+CurvePoint CurvePoint::multiplyGenerator(const Uint256 &n) {
+	/* 
+	 * Fixed-base comb method. Split n into windows of w bits, n = sum(d_i * 2^(i*w)).
+	 * Then n * G = sum(d_i * (2^(i*w) * G)), where every term is read from the precomputed table.
+	 * Algorithm pseudocode:
+	 * result = zero
+	 * for (i = 0 .. numWindows-1) {
+	 *   d = (n >> (i * w)) % 2^w
+	 *   if (d != 0)
+	 *     result += table[i][d]
+	 * }
+	 */
+	countOps(functionOps);
+	constexpr int windowBits = GENERATOR_TABLE_BITS;
+	constexpr int windowLen = 1 << windowBits;
+	constexpr int numWindows = (Uint256::NUM_WORDS * 32 + windowBits - 1) / windowBits;
+	const std::vector<AffinePoint> &table = getGeneratorTable();
+	
+	CurvePoint result;
+	countOps(1 * curvepointCopyOps);
+	for (int i = 0; i < numWindows; i++) {
+		countOps(loopBodyOps);
+		int bit = i * windowBits;
+		uint32_t digit = n.value[bit >> 5] >> (bit & 31);
+		if ((bit & 31) + windowBits > 32 && (bit >> 5) + 1 < Uint256::NUM_WORDS)  // Depends only on the public loop index
+			digit |= n.value[(bit >> 5) + 1] << (32 - (bit & 31));
+		digit &= windowLen - 1;
+		countOps(14 * arithmeticOps);
+		
+		// Scan the entire window so that the memory access pattern is independent of the digit
+		const AffinePoint *entries = &table[static_cast<std::size_t>(i) * (windowLen - 1)];
+		AffinePoint q = AffinePoint::ZERO;  // Stays zero if the digit is zero
+		for (int j = 1; j < windowLen; j++) {
+			countOps(loopBodyOps);
+			q.replace(entries[j - 1], static_cast<uint32_t>(static_cast<uint32_t>(j) == digit));
+			countOps(2 * arithmeticOps);
+		}
+		result.addMixed(q);
+		countOps(2 * fieldintCopyOps);
+	}
+	return result;
+}
+
+
+CurvePoint CurvePoint::multiplyGeneratorVar(const PublicScalar &n) {
+	// Same windows as multiplyGenerator(), but with direct table lookups and no work for zero windows
+	countOps(functionOps);
+	constexpr int windowBits = GENERATOR_TABLE_BITS;
+	constexpr int windowLen = 1 << windowBits;
+	constexpr int numWindows = (Uint256::NUM_WORDS * 32 + windowBits - 1) / windowBits;
+	const std::vector<AffinePoint> &table = getGeneratorTable();
+	const Uint256 &k = n.getValue();
+	
+	JacobianPoint result;
+	countOps(1 * curvepointCopyOps);
+	for (int i = 0; i < numWindows; i++) {
+		countOps(loopBodyOps);
+		int bit = i * windowBits;
+		uint32_t digit = k.value[bit >> 5] >> (bit & 31);
+		if ((bit & 31) + windowBits > 32 && (bit >> 5) + 1 < Uint256::NUM_WORDS)
+			digit |= k.value[(bit >> 5) + 1] << (32 - (bit & 31));
+		digit &= windowLen - 1;
+		countOps(14 * arithmeticOps);
+		if (digit != 0) {
+			result.addMixedVar(table[static_cast<std::size_t>(i) * (windowLen - 1) + digit - 1]);
+			countOps(3 * arithmeticOps);
+		}
+	}
+	return result.toCurvePoint();
+}
+
+
+CurvePoint CurvePoint::multiplySumVar(const PublicScalar scalars[], const CurvePoint points[], std::size_t len) {
+	countOps(functionOps);
+	std::vector<int8_t> digits(len * 2 * (Uint256::NUM_WORDS * 32 + 1));
+	std::vector<JacobianPoint> multiples(len * WNAF_TABLE_LEN);
+	std::vector<AffinePoint> tables(len * 2 * WNAF_TABLE_LEN);
+	std::vector<uint32_t> lambdaNegs(len);
+	return multiplySumStraussVar(scalars, points, len, digits.data(), multiples.data(), tables.data(), lambdaNegs.data());
+}
+
+
+CurvePoint CurvePoint::multiplySumVar(const PublicScalar scalars[], const CurvePoint points[], std::size_t len, MultiplySumScratch &scratch) {
+	countOps(functionOps);
+	assert(len <= scratch.maxLen);
+	if (len <= MultiplySumScratch::STRAUSS_MAX_LEN) {
+		return multiplySumStraussVar(scalars, points, len, scratch.wnafDigits.data(),
+			scratch.multiples.data(), scratch.tables.data(), scratch.lambdaNegs.data());
+	} else
+		return multiplySumPippengerVar(scalars, points, len, scratch);
+}
+
+
+CurvePoint CurvePoint::multiplySumStraussVar(const PublicScalar scalars[], const CurvePoint points[], std::size_t len,
+		int8_t digits[], JacobianPoint multiples[], AffinePoint tables[], uint32_t lambdaNegs[]) {
+	// Split every scalar with the GLV endomorphism into two halves of at most 128 bits (see multiply()),
+	// giving 2 * len terms but only half the doublings. Then recode every half in wNAF and precompute
+	// the odd multiples [p*1, p*3, ..., p*(2*WNAF_TABLE_LEN-1)] of every term's point, in affine coordinates.
+	countOps(functionOps);
+	static_assert(4 <= WNAF_WINDOW_BITS && WNAF_WINDOW_BITS <= 8, "Unsupported wNAF width");
+	constexpr int maxDigits = Uint256::NUM_WORDS * 32 + 1;
+	int top = 0;
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		Scalar r1(Uint256::ZERO), r2(Uint256::ZERO);
+		Scalar::splitLambdaVar(Scalar(scalars[i].getValue()), r1, r2);
+		Uint256 k1, k2;
+		uint32_t neg1 = toMagnitude(r1, k1);
+		uint32_t neg2 = toMagnitude(r2, k2);
+		int len1 = PublicScalar(k1).toWnaf(WNAF_WINDOW_BITS, &digits[(i * 2 + 0) * maxDigits]);
+		int len2 = PublicScalar(k2).toWnaf(WNAF_WINDOW_BITS, &digits[(i * 2 + 1) * maxDigits]);
+		top = std::max(top, std::max(len1, len2));
+		lambdaNegs[i] = neg1 ^ neg2;
+		
+		JacobianPoint *table = &multiples[i * WNAF_TABLE_LEN];
+		table[0] = JacobianPoint(points[i]);
+		if (neg1 != 0)
+			table[0].negate();
+		JacobianPoint doubled = table[0];
+		doubled.twice();
+		for (int j = 1; j < WNAF_TABLE_LEN; j++) {
+			countOps(loopBodyOps);
+			table[j] = table[j - 1];
+			table[j].addVar(doubled);
+			countOps(1 * curvepointCopyOps);
+		}
+		countOps(3 * curvepointCopyOps);
+		countOps(6 * uint256CopyOps);
+		countOps(8 * arithmeticOps);
+	}
+	
+	// Convert all the multiples to affine with one inversion, then derive the lambda tables,
+	// giving tables = [P table of every point..., lambda table of every point...]
+	JacobianPoint::toAffineBatchVar(multiples, tables, len * WNAF_TABLE_LEN);
+	for (std::size_t i = 0; i < len * WNAF_TABLE_LEN; i++) {
+		countOps(loopBodyOps);
+		AffinePoint &q = tables[len * WNAF_TABLE_LEN + i];
+		q = tables[i];
+		q.x.multiply(BETA);
+		if (lambdaNegs[i / WNAF_TABLE_LEN] != 0)
+			q.negate();
+		countOps(2 * fieldintCopyOps);
+	}
+	
+	// Process all halves from the most significant digit, sharing the doublings (interleaved wNAF)
+	JacobianPoint result;
+	bool isZero = true;  // Skip doubling the initial zero point
+	countOps(1 * curvepointCopyOps);
+	for (int i = top - 1; i >= 0; i--) {
+		countOps(loopBodyOps);
+		if (!isZero)
+			result.twice();
+		for (std::size_t j = 0; j < len * 2; j++) {
+			countOps(loopBodyOps);
+			int digit = digits[j * maxDigits + i];
+			if (digit != 0) {
+				std::size_t offset = ((j & 1) * len + j / 2) * WNAF_TABLE_LEN;
+				addWnafDigitVar(result, &tables[offset], digit);
+				isZero = false;
+			}
+			countOps(4 * arithmeticOps);
+		}
+	}
+	return result.toCurvePoint();
+}
+
+
+CurvePoint CurvePoint::multiplySumPippengerVar(const PublicScalar scalars[], const CurvePoint points[], std::size_t len,
+		MultiplySumScratch &scratch) {
+	// Split every scalar with the GLV endomorphism as in multiplySumStraussVar(), giving 2 * len terms whose
+	// points are affine and carry the signs of the halves, and recode every half into signed windows
+	countOps(functionOps);
+	const std::size_t numTerms = len * 2;
+	const int windowBits = MultiplySumScratch::getWindowBits(numTerms);
+	const int numWindows = MultiplySumScratch::getNumWindows(windowBits);
+	CurvePoint *normalized = scratch.normalized.data();
+	std::copy(points, points + len, normalized);
+	normalizeBatchVar(normalized, len);
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		Scalar r1(Uint256::ZERO), r2(Uint256::ZERO);
+		Scalar::splitLambdaVar(Scalar(scalars[i].getValue()), r1, r2);
+		Uint256 k1, k2;
+		uint32_t neg1 = toMagnitude(r1, k1);
+		uint32_t neg2 = toMagnitude(r2, k2);
+		AffinePoint &p = scratch.terms[i * 2 + 0];
+		AffinePoint &q = scratch.terms[i * 2 + 1];
+		if (normalized[i].isZero()) {
+			p = AffinePoint::ZERO;
+			q = AffinePoint::ZERO;
+			k1 = Uint256::ZERO;
+			k2 = Uint256::ZERO;
+		} else {
+			p = AffinePoint(normalized[i].x, normalized[i].y);
+			q = p;
+			q.x.multiply(BETA);
+			p.negate(neg1);
+			q.negate(neg2);
+		}
+		toSignedDigitsVar(k1, windowBits, numWindows, &scratch.digits[i * 2 + 0], numTerms);
+		toSignedDigitsVar(k2, windowBits, numWindows, &scratch.digits[i * 2 + 1], numTerms);
+		countOps(4 * curvepointCopyOps);
+		countOps(6 * uint256CopyOps);
+		countOps(2 * arithmeticOps);
+	}
+	
+	// Sum the buckets of every window, splitting contiguous ranges of windows among the threads
+	unsigned int numThreads = std::min(scratch.numThreads, static_cast<unsigned int>(numWindows));
+	if (numThreads <= 1)
+		sumWindowsVar(scratch, numTerms, windowBits, 0, numWindows, 0);
+	else {
+		std::vector<std::thread> threads;
+		int chunkLen = (numWindows + static_cast<int>(numThreads) - 1) / static_cast<int>(numThreads);
+		unsigned int slot = 0;
+		try {
+			for (int start = 0; start < numWindows; start += chunkLen, slot++) {
+				threads.emplace_back(sumWindowsVar, std::ref(scratch), numTerms, windowBits,
+					start, std::min(start + chunkLen, numWindows), slot);
+			}
+		} catch (...) {
+			// Destroying a joinable thread would call std::terminate(), so wait for the started ones first
+			for (std::thread &th : threads)
+				th.join();
+			throw;
+		}
+		for (std::thread &th : threads)
+			th.join();
+	}
+	
+	// Combine the window sums from the most significant one, doubling windowBits times between windows
+	JacobianPoint result;
+	for (int i = numWindows - 1; i >= 0; i--) {
+		countOps(loopBodyOps);
+		for (int j = 0; j < windowBits && !result.isZero(); j++) {
+			countOps(loopBodyOps);
+			result.twice();
+		}
+		result.addVar(scratch.windowSums[i]);
+	}
+	return result.toCurvePoint();
+}
+
+
+void CurvePoint::sumWindowsVar(MultiplySumScratch &scratch, std::size_t numTerms, int windowBits,
+		int startWindow, int endWindow, unsigned int slot) {
+	countOps(functionOps);
+	const std::size_t maxBuckets = scratch.bucketLens.size() / scratch.numThreads;
+	const std::size_t numBuckets = static_cast<std::size_t>(1) << (windowBits - 1);
+	AffinePoint *sorted = &scratch.sorted[slot * scratch.maxLen * 2];
+	FieldInt *denominators = &scratch.denominators[slot * scratch.maxLen];
+	FieldInt *inverseScratch = &scratch.inverseScratch[slot * scratch.maxLen];
+	uint32_t *starts = &scratch.bucketStarts[slot * (maxBuckets + 1)];
+	uint32_t *lens = &scratch.bucketLens[slot * maxBuckets];
+	assert(numBuckets <= maxBuckets);
+	
+	for (int window = startWindow; window < endWindow; window++) {
+		countOps(loopBodyOps);
+		
+		// Counting sort of the terms by bucket (digit magnitude - 1), negating the points of negative digits
+		const int16_t *digits = &scratch.digits[window * numTerms];
+		std::fill(lens, lens + numBuckets, 0);
+		for (std::size_t i = 0; i < numTerms; i++) {
+			countOps(loopBodyOps);
+			if (digits[i] != 0)
+				lens[std::abs(digits[i]) - 1]++;
+		}
+		starts[0] = 0;
+		for (std::size_t i = 0; i < numBuckets; i++) {
+			countOps(loopBodyOps);
+			starts[i + 1] = starts[i] + lens[i];
+			lens[i] = 0;
+		}
+		for (std::size_t i = 0; i < numTerms; i++) {
+			countOps(loopBodyOps);
+			int digit = digits[i];
+			if (digit == 0)
+				continue;
+			std::size_t bucket = static_cast<std::size_t>(std::abs(digit) - 1);
+			AffinePoint &p = sorted[starts[bucket] + lens[bucket]];
+			p = scratch.terms[i];
+			if (digit < 0)
+				p.negate();
+			lens[bucket]++;
+			countOps(1 * curvepointCopyOps);
+		}
+		
+		// Sum every bucket's points pairwise in rounds, halving the bucket lengths. The additions
+		// in a round are independent, so all their slope denominators share one inversion.
+		while (true) {
+			countOps(loopBodyOps);
+			bool done = true;
+			for (std::size_t i = 0; i < numBuckets && done; i++)
+				done = lens[i] <= 1;
+			if (done)
+				break;
+			
+			std::size_t numPairs = 0;
+			for (std::size_t i = 0; i < numBuckets; i++) {
+				countOps(loopBodyOps);
+				for (uint32_t j = 0; j + 1 < lens[i]; j += 2) {
+					countOps(loopBodyOps);
+					const AffinePoint &p = sorted[starts[i] + j];
+					const AffinePoint &q = sorted[starts[i] + j + 1];
+					if (p.isZero() || q.isZero())
+						continue;
+					if (p.x != q.x) {
+						denominators[numPairs] = q.x;
+						denominators[numPairs].subtract(p.x);
+						numPairs++;
+					} else if (p.y == q.y) {
+						denominators[numPairs] = p.y;
+						denominators[numPairs].multiply2();
+						numPairs++;
+					}  // Else the points are opposite and sum to zero
+					countOps(1 * fieldintCopyOps);
+				}
+			}
+			FieldInt::reciprocalBatchVar(denominators, numPairs, inverseScratch);
+			
+			std::size_t k = 0;
+			for (std::size_t i = 0; i < numBuckets; i++) {
+				countOps(loopBodyOps);
+				AffinePoint *bucket = &sorted[starts[i]];
+				uint32_t n = lens[i];
+				for (uint32_t j = 0; j + 1 < n; j += 2) {
+					countOps(loopBodyOps);
+					bucket[j / 2] = addAffinePairVar(bucket[j], bucket[j + 1], denominators, k);
+					countOps(1 * curvepointCopyOps);
+				}
+				if (n % 2 == 1)
+					bucket[n / 2] = bucket[n - 1];
+				lens[i] = (n + 1) / 2;
+			}
+			assert(k == numPairs);
+		}
+		
+		// The window's sum is 1 * bucket[0] + 2 * bucket[1] + ..., which is the sum of the running sums from the top
+		JacobianPoint running;
+		JacobianPoint sum;
+		for (std::size_t i = numBuckets; i-- > 0; ) {
+			countOps(loopBodyOps);
+			if (lens[i] != 0)
+				running.addMixedVar(sorted[starts[i]]);
+			sum.addVar(running);
+		}
+		scratch.windowSums[window] = sum;
+		countOps(3 * curvepointCopyOps);
+	}
+}
+
+
+AffinePoint CurvePoint::addAffinePairVar(const AffinePoint &p, const AffinePoint &q, const FieldInt inverses[], std::size_t &index) {
+	/* 
+	 * Algorithm pseudocode (the inverse is 1 / (q.x - p.x), or 1 / (2 * p.y) for doubling):
+	 * if (p == zero) return q
+	 * if (q == zero) return p
+	 * if (p == -q) return zero
+	 * s = p == q ? 3 * p.x^2 * inverse : (q.y - p.y) * inverse
+	 * x = s^2 - p.x - q.x
+	 * y = s * (p.x - x) - p.y
+	 */
+	countOps(functionOps);
+	if (p.isZero())
+		return q;
+	if (q.isZero())
+		return p;
+	FieldInt s = q.y;
+	if (p.x != q.x)
+		s.subtract(p.y);
+	else if (p.y == q.y) {
+		s = p.x;
+		s.square();
+		FieldInt t = s;
+		s.multiply2();
+		s.add(t);
+		countOps(1 * fieldintCopyOps);
+	} else
+		return AffinePoint::ZERO;
+	s.multiply(inverses[index]);
+	index++;
+	
+	AffinePoint result;
+	result.x = s;
+	result.x.square();
+	result.x.subtract(p.x);
+	result.x.subtract(q.x);
+	result.y = p.x;
+	result.y.subtract(result.x);
+	result.y.multiply(s);
+	result.y.subtract(p.y);
+	countOps(4 * fieldintCopyOps);
+	countOps(4 * arithmeticOps);
+	return result;
+}
+
+
+void CurvePoint::toSignedDigitsVar(const Uint256 &k, int windowBits, int numWindows, int16_t digits[], std::size_t stride) {
+	countOps(functionOps);
+	const int half = 1 << (windowBits - 1);
+	int carry = 0;
+	for (int i = 0; i < numWindows; i++) {
+		countOps(loopBodyOps);
+		int pos = i * windowBits;
+		uint32_t bits = 0;
+		if (pos < Uint256::NUM_WORDS * 32) {
+			int word = pos >> 5;
+			int shift = pos & 31;
+			bits = k.value[word] >> shift;
+			if (shift + windowBits > 32 && word + 1 < Uint256::NUM_WORDS)
+				bits |= k.value[word + 1] << (32 - shift);
+		}
+		int digit = static_cast<int>(bits & ((UINT32_C(1) << windowBits) - 1)) + carry;
+		carry = 0;
+		if (digit >= half && i < numWindows - 1) {  // The top window takes no carry out, because k < 2^128
+			digit -= half * 2;
+			carry = 1;
+		}
+		assert(-half <= digit && digit <= half);
+		digits[i * stride] = static_cast<int16_t>(digit);
+		countOps(6 * arithmeticOps);
+	}
+	assert(carry == 0);
+}
+
+
+void CurvePoint::normalizeBatch(CurvePoint points[], std::size_t len) {
+	/* 
+	 * Montgomery's trick: with p[i] = z[0] * ... * z[i] (using 1 in place of zero z values), invert only
+	 * p[len-1], then walk backward: 1/z[i] = 1/p[i] * p[i-1], and 1/p[i-1] = 1/p[i] * z[i].
+	 */
+	countOps(functionOps);
+	if (len == 0)
+		return;
+	std::vector<FieldInt> prefixes;
+	prefixes.reserve(len);
+	FieldInt acc = FI_ONE;
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		FieldInt zi = points[i].z;
+		zi.replace(FI_ONE, static_cast<uint32_t>(zi == FI_ZERO));
+		acc.multiply(zi);
+		prefixes.push_back(acc);
+		countOps(1 * arithmeticOps);
+		countOps(3 * fieldintCopyOps);
+	}
+	acc.reciprocal();
+	for (std::size_t i = len; i-- > 0; ) {
+		countOps(loopBodyOps);
+		CurvePoint &p = points[i];
+		uint32_t isNonzero = static_cast<uint32_t>(p.z != FI_ZERO);
+		FieldInt inv = acc;  // 1 / z[i]
+		if (i > 0)  // Depends only on the public loop index
+			inv.multiply(prefixes[i - 1]);
+		FieldInt zi = p.z;
+		zi.replace(FI_ONE, isNonzero ^ 1);
+		acc.multiply(zi);
+		
+		// Same selection as normalize()
+		CurvePoint norm = p;
+		norm.x.multiply(inv);
+		norm.y.multiply(inv);
+		norm.z = FI_ONE;
+		p.x.replace(FI_ONE, static_cast<uint32_t>(p.x != FI_ZERO));
+		p.y.replace(FI_ONE, static_cast<uint32_t>(p.y != FI_ZERO));
+		p.replace(norm, isNonzero);
+		countOps(4 * arithmeticOps);
+		countOps(3 * fieldintCopyOps);
+		countOps(1 * curvepointCopyOps);
+	}
+}
+
+
+void CurvePoint::normalizeBatchVar(CurvePoint points[], std::size_t len) {
+	// Same algorithm as normalizeBatch(), but points at infinity are handled by branching
+	countOps(functionOps);
+	std::vector<FieldInt> prefixes;
+	prefixes.reserve(len);
+	FieldInt acc = FI_ONE;
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		if (points[i].z != FI_ZERO)
+			acc.multiply(points[i].z);
+		prefixes.push_back(acc);
+		countOps(1 * arithmeticOps);
+		countOps(1 * fieldintCopyOps);
+	}
+	acc.reciprocalVar();
+	for (std::size_t i = len; i-- > 0; ) {
+		countOps(loopBodyOps);
+		CurvePoint &p = points[i];
+		if (p.z == FI_ZERO) {
+			p.normalizeVar();  // Needs no inversion
+			countOps(1 * arithmeticOps);
+			continue;
+		}
+		FieldInt inv = acc;
+		if (i > 0)
+			inv.multiply(prefixes[i - 1]);
+		acc.multiply(p.z);
+		p.x.multiply(inv);
+		p.y.multiply(inv);
+		p.z = FI_ONE;
+		countOps(2 * arithmeticOps);
+		countOps(2 * fieldintCopyOps);
+	}
+}
+
+
 CurvePoint CurvePoint::privateExponentToPublicPoint(const Uint256 &privExp) {
 	assert((Uint256::ZERO < privExp) & (privExp < CurvePoint::ORDER));
-	CurvePoint result = CurvePoint::G;
-	result.multiply(privExp);
+	CurvePoint result = multiplyGenerator(privExp);
 	result.normalize();
 	return result;
 }
 
 
+bool CurvePoint::fromCompressedPoint(const uint8_t input[33], CurvePoint &outPoint) {
+	countOps(functionOps);
+	assert(input != nullptr);
+	if (input[0] != 0x02 && input[0] != 0x03)
+		return false;
+	const Uint256 xVal(&input[1]);
+	const FieldInt x(xVal);
+	if (Uint256(x) != xVal)  // Not less than the modulus
+		return false;
+	
+	// y^2 = x^3 + B
+	FieldInt y = x;
+	y.square();
+	y.multiply(x);
+	y.add(B);
+	if (!y.sqrt())
+		return false;
+	CurvePoint result(x, y);
+	result.negate((y.value[0] ^ input[0]) & 1);
+	outPoint = result;
+	countOps(5 * arithmeticOps);
+	countOps(3 * fieldintCopyOps);
+	countOps(2 * curvepointCopyOps);
+	return true;
+}
+
+
+bool CurvePoint::fromCompressedPointVar(const uint8_t input[33], CurvePoint &outPoint) {
+	countOps(functionOps);
+	assert(input != nullptr);
+	if (input[0] != 0x02 && input[0] != 0x03)
+		return false;
+	const Uint256 xVal(&input[1]);
+	const FieldInt x(xVal);
+	if (Uint256(x) != xVal)  // Not less than the modulus
+		return false;
+	
+	// y^2 = x^3 + B, which is never zero because -B is not a cube modulo the prime
+	FieldInt y = x;
+	y.square();
+	y.multiply(x);
+	y.add(B);
+	if (y.jacobiVar() != 1 || !y.sqrt())  // The square root always exists after the Legendre symbol check
+		return false;
+	CurvePoint result(x, y);
+	if (((y.value[0] ^ input[0]) & 1) != 0)
+		result.negate();
+	outPoint = result;
+	countOps(6 * arithmeticOps);
+	countOps(3 * fieldintCopyOps);
+	countOps(2 * curvepointCopyOps);
+	return true;
+}
+
+
+bool CurvePoint::fromUncompressedPoint(const uint8_t input[65], CurvePoint &outPoint) {
+	countOps(functionOps);
+	assert(input != nullptr);
+	if (input[0] != 0x04)
+		return false;
+	const Uint256 xVal(&input[1]);
+	const Uint256 yVal(&input[33]);
+	const FieldInt x(xVal);
+	const FieldInt y(yVal);
+	if (Uint256(x) != xVal || Uint256(y) != yVal)  // Not less than the modulus
+		return false;
+	CurvePoint result(x, y);
+	if (!result.isOnCurve())
+		return false;
+	outPoint = result;
+	countOps(4 * arithmeticOps);
+	countOps(4 * fieldintCopyOps);
+	countOps(2 * curvepointCopyOps);
+	return true;
+}
+
+
+void CurvePoint::multiplyB3(FieldInt &val) {
+	// B = 7, so 3 * B = 21 = ((1 * 4 + 1) * 4 + 1)
+	countOps(functionOps);
+	const FieldInt orig = val;
+	val.multiply2();
+	val.multiply2();
+	val.add(orig);
+	val.multiply2();
+	val.multiply2();
+	val.add(orig);
+	countOps(1 * fieldintCopyOps);
+}
+
+
+void CurvePoint::makeTable(const CurvePoint &p, AffinePoint table[TABLE_LEN]) {
+	// Precompute [p*0, p*1, ..., p*15], using mixed additions of the affine p and one final batch inversion
+	countOps(functionOps);
+	CurvePoint multiples[TABLE_LEN];  // Starts as all zeros
+	multiples[1] = p;
+	multiples[1].normalize();
+	AffinePoint pa(multiples[1].x, multiples[1].y);
+	pa.replace(AffinePoint::ZERO, static_cast<uint32_t>(multiples[1].isZero()));
+	multiples[2] = multiples[1];
+	multiples[2].twice();
+	for (int i = 3; i < TABLE_LEN; i++) {
+		countOps(loopBodyOps);
+		multiples[i] = multiples[i - 1];
+		multiples[i].addMixed(pa);
+		countOps(2 * arithmeticOps);
+		countOps(1 * curvepointCopyOps);
+	}
+	normalizeBatch(&multiples[2], TABLE_LEN - 2);
+	for (int i = 0; i < TABLE_LEN; i++) {
+		countOps(loopBodyOps);
+		table[i] = AffinePoint(multiples[i].x, multiples[i].y);
+		table[i].replace(AffinePoint::ZERO, static_cast<uint32_t>(multiples[i].isZero()));
+		countOps(2 * fieldintCopyOps);
+	}
+	countOps(3 * curvepointCopyOps);
+}
+
+
+CurvePoint CurvePoint::multiplyAddTables(const Uint256 &u1, const AffinePoint tableP[TABLE_LEN],
+		const Uint256 &u2, const AffinePoint tableQ[TABLE_LEN], int numBits) {
+	// Process TABLE_BITS of both numbers per iteration, sharing the doublings (interleaved windowed method)
+	countOps(functionOps);
+	assert(0 < numBits && numBits <= Uint256::NUM_WORDS * 32);
+	CurvePoint result;
+	countOps(1 * curvepointCopyOps);
+	for (int i = (numBits - 1) / TABLE_BITS * TABLE_BITS; i >= 0; i -= TABLE_BITS) {
+		countOps(loopBodyOps);
+		unsigned int incP = (u1.value[i >> 5] >> (i & 31)) & (TABLE_LEN - 1);
+		unsigned int incQ = (u2.value[i >> 5] >> (i & 31)) & (TABLE_LEN - 1);
+		AffinePoint s = AffinePoint::ZERO;  // Dummy initial values
+		AffinePoint t = AffinePoint::ZERO;
+		countOps(10 * arithmeticOps);
+		countOps(4 * fieldintCopyOps);
+		for (unsigned int j = 0; j < TABLE_LEN; j++) {
+			countOps(loopBodyOps);
+			s.replace(tableP[j], static_cast<uint32_t>(j == incP));
+			t.replace(tableQ[j], static_cast<uint32_t>(j == incQ));
+			countOps(2 * arithmeticOps);
+		}
+		result.addMixed(s);
+		result.addMixed(t);
+		if (i != 0) {
+			for (int j = 0; j < TABLE_BITS; j++) {
+				countOps(loopBodyOps);
+				result.twice();
+			}
+		}
+	}
+	return result;
+}
+
+
+uint32_t CurvePoint::toMagnitude(const Scalar &r, Uint256 &out) {
+	countOps(functionOps);
+	out = Uint256(r);
+	Scalar neg = r;
+	neg.negate();
+	uint32_t isNeg = static_cast<uint32_t>((out.value[4] | out.value[5] | out.value[6] | out.value[7]) != 0);
+	out.replace(Uint256(neg), isNeg);
+	assert((out.value[4] | out.value[5] | out.value[6] | out.value[7]) == 0);
+	countOps(8 * arithmeticOps);
+	countOps(3 * uint256CopyOps);
+	return isNeg;
+}
+
+
+void CurvePoint::addWnafDigitVar(JacobianPoint &point, const AffinePoint table[], int digit) {
+	countOps(functionOps);
+	if (digit > 0)
+		point.addMixedVar(table[(digit - 1) / 2]);
+	else {
+		AffinePoint neg = table[(-digit - 1) / 2];
+		neg.negate();
+		point.addMixedVar(neg);
+		countOps(2 * fieldintCopyOps);
+	}
+	countOps(2 * arithmeticOps);
+}
+
+
+const std::vector<AffinePoint> &CurvePoint::getGeneratorTable() {
+	static const std::vector<AffinePoint> table = makeGeneratorTable();
+	return table;
+}
+
+
+std::vector<AffinePoint> CurvePoint::makeGeneratorTable() {
+	constexpr int windowBits = GENERATOR_TABLE_BITS;
+	static_assert(1 <= windowBits && windowBits <= 12, "Unsupported generator table width");
+	constexpr int windowLen = 1 << windowBits;
+	constexpr int numWindows = (Uint256::NUM_WORDS * 32 + windowBits - 1) / windowBits;
+	std::vector<JacobianPoint> multiples;
+	multiples.reserve(static_cast<std::size_t>(numWindows) * (windowLen - 1));
+	
+	JacobianPoint base(G);  // Equal to 2^(i*w) * G at the start of each window
+	for (int i = 0; i < numWindows; i++) {
+		JacobianPoint p = base;
+		for (int j = 1; j < windowLen; j++) {
+			multiples.push_back(p);
+			p.addVar(base);
+		}
+		base = p;  // Now equal to 2^w * base
+	}
+	
+	// All the points are public, so convert them to affine with a single variable-time inversion
+	std::vector<AffinePoint> result(multiples.size());
+	JacobianPoint::toAffineBatchVar(multiples.data(), result.data(), multiples.size());
+	return result;
+}
+
+
 // Static initializers
 const FieldInt CurvePoint::FI_ZERO("0000000000000000000000000000000000000000000000000000000000000000");
 const FieldInt CurvePoint::FI_ONE ("0000000000000000000000000000000000000000000000000000000000000001");
 const FieldInt CurvePoint::A    ("0000000000000000000000000000000000000000000000000000000000000000");
 const FieldInt CurvePoint::B    ("0000000000000000000000000000000000000000000000000000000000000007");
 const Uint256  CurvePoint::ORDER("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
+const FieldInt CurvePoint::BETA ("7AE96A2B657C07106E64479EAC3434E99CF0497512F58995C1396C28719501EE");
 const CurvePoint CurvePoint::G(
 	FieldInt("79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798"),
 	FieldInt("483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8"));
@@ -8,10 +8,35 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
+#include "AffinePoint.hpp"
 #include "FieldInt.hpp"
+#include "Scalar.hpp"
 #include "Uint256.hpp"
 
+class JacobianPoint;       // Forward declaration
+class MultiplySumScratch;  // Forward declaration
+class PublicScalar;        // Forward declaration
+
+
+// Width in bits of each window of the fixed-base table used by CurvePoint::multiplyGenerator().
+// The table holds ceil(256 / bits) * (2^bits - 1) affine points of 64 bytes each, for example:
+// 3 -> 38 KiB, 4 -> 60 KiB (default), 7 -> 294 KiB, 9 -> 948 KiB. Override with -DGENERATOR_TABLE_BITS=n.
+#ifndef GENERATOR_TABLE_BITS
+	#define GENERATOR_TABLE_BITS 4
+#endif
+
+
+// Width in bits of the wNAF digits used by the variable-time multiplyVar() and multiplySumVar(), in the range [4, 8].
+// Every term needs a table of 2^(bits-2) odd multiples and then about 128 / (bits + 1) additions, so 5 (default) is
+// the cheapest for the 128-bit GLV halves; wider windows only pay off if a table is reused. Override with -DWNAF_WINDOW_BITS=n
+// and compare with CurvePointBenchmark.
+#ifndef WNAF_WINDOW_BITS
+	#define WNAF_WINDOW_BITS 5
+#endif
+
 
 /*
  * A point on the secp256k1 elliptic curve for Bitcoin use, in projective coordinates.
@@ -32,6 +57,10 @@
  */
 class CurvePoint final {
 	
+	private: static constexpr int TABLE_BITS = 4;  // Window width for multiply() and multiplyAdd()
+	private: static constexpr int TABLE_LEN = 1 << TABLE_BITS;
+	private: static constexpr int WNAF_TABLE_LEN = 1 << (WNAF_WINDOW_BITS - 2);  // Odd multiples 1, 3, ..., 2^(bits-1) - 1
+	
 	/*---- Fields ----*/
 	
 	public: FieldInt x;
@@ -57,8 +86,8 @@ class CurvePoint final {
 	
 	/*---- Arithmetic methods ----*/
 	
-	// Adds the given curve point to this point. The resulting state is
-	// usually not normalized. Constant-time with respect to both values.
+	// Adds the given curve point to this point, using complete formulas that need no special cases for zero,
+	// equal, or opposite points. The resulting state is usually not normalized. Constant-time with respect to both values.
 	public: void add(const CurvePoint &other);
 	
 	
@@ -67,16 +96,39 @@ class CurvePoint final {
 	public: void twice();
 	
 	
-	// Multiplies this point by the given unsigned integer. The resulting state
-	// is usually not normalized. Constant-time with respect to both values.
+	// Adds the given affine point (which may be zero) to this point, like add() but with fewer multiplications.
+	// The resulting state is usually not normalized. Constant-time with respect to both values.
+	private: void addMixed(const AffinePoint &other);
+	
+	
+	// Multiplies this point by the given unsigned integer, using the GLV endomorphism to halve the
+	// number of doublings. This point must be on the curve or zero (so that it has order dividing ORDER,
+	// and n is effectively reduced modulo ORDER). The resulting state is usually not normalized.
+	// Constant-time with respect to both values.
 	public: void multiply(const Uint256 &n);
 	
 	
+	// Multiplies this point by the given public number, with the same contract and result as multiply(), but using
+	// GLV halves in width-WNAF_WINDOW_BITS non-adjacent form and skipping all zero digits (about 50 additions instead
+	// of 128 additions and 256 table scans). Not constant-time; only for public values.
+	public: void multiplyVar(const PublicScalar &n);
+	
+	
 	// Normalizes the coordinates of this point. Idempotent operation.
 	// Constant-time with respect to this value.
 	public: void normalize();
 	
 	
+	// Normalizes the coordinates of this point, with the same result as normalize().
+	// Not constant-time; only use it on public values.
+	public: void normalizeVar();
+	
+	
+	// Negates this point (y becomes -y) if enable is 1, or does nothing if enable is 0.
+	// The normalization state is preserved. Constant-time with respect to both values.
+	public: void negate(std::uint32_t enable=1);
+	
+	
 	// Copies the given point into this point if enable is 1, or does nothing if enable is 0.
 	// Constant-time with respect to both values and the enable.
 	public: void replace(const CurvePoint &other, std::uint32_t enable);
@@ -109,13 +161,145 @@ class CurvePoint final {
 	public: void toCompressedPoint(std::uint8_t output[33]) const;
 	
 	
+	// Computes the Ethereum address of this public key point, which is the last 20 bytes of the Keccak-256 hash of
+	// the x and y coordinates in big-endian. This point needs to be normalized and nonzero before the method is called.
+	// Constant-time with respect to this value.
+	public: void toEthereumAddress(std::uint8_t output[20]) const;
+	
+	
 	/*---- Static functions ----*/
 	
+	// Returns the point u1 * p + u2 * q, computed with a single shared chain of doublings (Shamir's trick)
+	// instead of two separate multiplications. The resulting state is usually not normalized.
+	// Constant-time with respect to all four values.
+	public: static CurvePoint multiplyAdd(const Uint256 &u1, const CurvePoint &p, const Uint256 &u2, const CurvePoint &q);
+	
+	
+	// Returns the point n * G, using a table of precomputed multiples of G so that no doublings are
+	// needed. The table is built on the first call. The resulting state is usually not normalized.
+	// Constant-time with respect to the value (every table entry of every window is scanned).
+	public: static CurvePoint multiplyGenerator(const Uint256 &n);
+	
+	
+	// Returns the point n * G like multiplyGenerator(), but reading each window's entry directly and skipping
+	// zero windows. The resulting state is usually not normalized. Not constant-time; only for public values.
+	public: static CurvePoint multiplyGeneratorVar(const PublicScalar &n);
+	
+	
+	// Returns the point scalars[0] * points[0] + ... + scalars[len - 1] * points[len - 1], computed with a single
+	// shared chain of doublings. Each scalar is split with the GLV endomorphism (as in multiply()) and each half is
+	// recoded in width-WNAF_WINDOW_BITS non-adjacent form, whose zero digits are skipped. The chain starts at the
+	// highest nonzero digit among all the halves, so scalars below 2^128 are not split at all.
+	// The points must be on the curve or zero. The resulting state is usually not normalized.
+	// Not constant-time; only for public values.
+	public: static CurvePoint multiplySumVar(const PublicScalar scalars[], const CurvePoint points[], std::size_t len);
+	
+	
+	// Returns the same point as the other multiplySumVar(), using only the given caller-owned working memory, which
+	// must have been constructed for at least len terms. Up to MultiplySumScratch::STRAUSS_MAX_LEN terms, this uses the
+	// same interleaved wNAF (Strauss) method. Longer sums use Pippenger's bucket method on the 2 * len GLV halves:
+	// each window's buckets are summed with affine additions whose inversions are batched (Montgomery's trick), and
+	// the windows are split among the scratch's threads. Not constant-time; only for public values.
+	public: static CurvePoint multiplySumVar(const PublicScalar scalars[], const CurvePoint points[], std::size_t len,
+		MultiplySumScratch &scratch);
+	
+	
+	// Normalizes all the given points, with the same results as calling normalize() on each one, but using
+	// a single field inversion and 3 multiplications per point instead of one inversion per point (Montgomery's
+	// trick). Points at infinity are allowed. Constant-time with respect to the values, but not the length.
+	public: static void normalizeBatch(CurvePoint points[], std::size_t len);
+	
+	
+	// Normalizes all the given points, with the same results as normalizeBatch(). Points at infinity
+	// are skipped in the shared inversion. Not constant-time; only use it on public values.
+	public: static void normalizeBatchVar(CurvePoint points[], std::size_t len);
+	
+	
 	// Returns a normalized public curve point for the given private exponent key.
 	// Requires 0 < privExp < ORDER. Constant-time with respect to the value.
 	public: static CurvePoint privateExponentToPublicPoint(const Uint256 &privExp);
 	
 	
+	// Parses the given point in compressed format (header byte 0x02 or 0x03 for the parity of y, then x in big-endian),
+	// as produced by toCompressedPoint(). Returns true and sets outPoint to the normalized point if the header is valid,
+	// x is less than the modulus, and x is the x coordinate of a curve point; otherwise returns false.
+	// Constant-time with respect to the coordinates, apart from the returned validity.
+	public: static bool fromCompressedPoint(const std::uint8_t input[33], CurvePoint &outPoint);
+	
+	
+	// Parses the given point in compressed format, with the same result as fromCompressedPoint(). An x coordinate that
+	// is not on the curve is rejected by the Legendre symbol of x^3 + B (FieldInt::jacobiVar()), which costs about a
+	// quarter of the square root. Not constant-time; only use it on public values.
+	public: static bool fromCompressedPointVar(const std::uint8_t input[33], CurvePoint &outPoint);
+	
+	
+	// Parses the given point in uncompressed format (header byte 0x04, then x and y in big-endian). Returns true and
+	// sets outPoint to the normalized point if the header is valid, both coordinates are less than the modulus, and
+	// the point is on the curve; otherwise returns false. Constant-time with respect to the coordinates, apart from
+	// the returned validity.
+	public: static bool fromUncompressedPoint(const std::uint8_t input[65], CurvePoint &outPoint);
+	
+	
+	// Sets val = val * 3 * B, using only additions. Constant-time with respect to the value.
+	private: static void multiplyB3(FieldInt &val);
+	
+	
+	// Sets table[i] = i * p for 0 <= i < TABLE_LEN, in affine coordinates. Constant-time with respect to the point.
+	private: static void makeTable(const CurvePoint &p, AffinePoint table[TABLE_LEN]);
+	
+	
+	// Returns u1 * P + u2 * Q given the tables of multiples of P and Q, reading only the
+	// low numBits bits of u1 and u2. Constant-time with respect to all values.
+	private: static CurvePoint multiplyAddTables(const Uint256 &u1, const AffinePoint tableP[TABLE_LEN],
+		const Uint256 &u2, const AffinePoint tableQ[TABLE_LEN], int numBits);
+	
+	
+	// Sets out to the magnitude of the GLV half r (r itself if it is below 2^128, otherwise ORDER - r),
+	// and returns 1 if r was negative or 0 otherwise. Constant-time with respect to the value.
+	private: static std::uint32_t toMagnitude(const Scalar &r, Uint256 &out);
+	
+	
+	// Computes the interleaved wNAF sum for multiplySumVar(), given arrays with room for len * 2 * 257 digits,
+	// len * WNAF_TABLE_LEN multiples, len * 2 * WNAF_TABLE_LEN table points, and len sign flags. Not constant-time.
+	private: static CurvePoint multiplySumStraussVar(const PublicScalar scalars[], const CurvePoint points[], std::size_t len,
+		std::int8_t digits[], JacobianPoint multiples[], AffinePoint tables[], std::uint32_t lambdaNegs[]);
+	
+	
+	// Computes the Pippenger bucket sum for multiplySumVar() with the given scratch. Not constant-time.
+	private: static CurvePoint multiplySumPippengerVar(const PublicScalar scalars[], const CurvePoint points[], std::size_t len,
+		MultiplySumScratch &scratch);
+	
+	
+	// Sets scratch.windowSums[i] for startWindow <= i < endWindow, using the given thread's slice of the scratch.
+	// Each bucket's points are added pairwise in rounds, so that even a bucket holding every term needs only
+	// a logarithmic number of inversions. Not constant-time.
+	private: static void sumWindowsVar(MultiplySumScratch &scratch, std::size_t numTerms, int windowBits,
+		int startWindow, int endWindow, unsigned int slot);
+	
+	
+	// Returns p + q in affine coordinates, where either may be zero. If the sum needs a slope, this reads its already
+	// inverted denominator at inverses[index] and increments index. Not constant-time.
+	private: static AffinePoint addAffinePairVar(const AffinePoint &p, const AffinePoint &q, const FieldInt inverses[], std::size_t &index);
+	
+	
+	// Writes the numWindows signed digits of the given number below 2^128 in base 2^windowBits at digits[i * stride],
+	// least significant first, where every digit is in the range [-2^(windowBits-1), 2^(windowBits-1)]. Not constant-time.
+	private: static void toSignedDigitsVar(const Uint256 &k, int windowBits, int numWindows, std::int16_t digits[], std::size_t stride);
+	
+	
+	// Adds table[(digit - 1) / 2] to the given point if digit > 0, or subtracts table[(-digit - 1) / 2]
+	// if digit < 0, where the table holds odd multiples. Not constant-time.
+	private: static void addWnafDigitVar(JacobianPoint &point, const AffinePoint table[], int digit);
+	
+	
+	// Returns the fixed-base table, building it on the first call (thread-safe in C++11). Window i holds
+	// j * 2^(i * GENERATOR_TABLE_BITS) * G for j = 1, 2, ..., 2^GENERATOR_TABLE_BITS - 1.
+	private: static const std::vector<AffinePoint> &getGeneratorTable();
+	
+	
+	private: static std::vector<AffinePoint> makeGeneratorTable();
+	
+	
 	/*---- Class constants ----*/
 	
 	public: static const FieldInt FI_ZERO;  // These FieldInt constants are declared here because they are only needed in this class,
@@ -123,6 +307,7 @@ class CurvePoint final {
 	public: static const FieldInt A;       // Curve equation parameter
 	public: static const FieldInt B;       // Curve equation parameter
 	public: static const Uint256 ORDER;    // Order of base point, which is a prime number
+	public: static const FieldInt BETA;    // Cube root of unity, where (BETA * x, y) = Scalar::LAMBDA * (x, y)
 	public: static const CurvePoint G;     // Base point (normalized)
 	public: static const CurvePoint ZERO;  // Dummy point at infinity (normalized)
 	
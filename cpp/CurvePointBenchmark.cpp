@@ -0,0 +1,77 @@
+/* 
+ * A runnable main program that measures and prints the wall-clock time of
+ * variable-base point multiplication, for comparing the wNAF widths of the
+ * variable-time paths (build with -DWNAF_WINDOW_BITS=n) with each other and
+ * with the constant-time 4-bit window.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "CurvePoint.hpp"
+#include "PublicScalar.hpp"
+#include "Uint256.hpp"
+
+
+static const long ITERATIONS = 200;
+static const int TRIALS = 3;
+
+static volatile std::uint32_t sink;  // Keeps the compiler from discarding the results
+
+
+// Returns the fastest of a few trials of the given operation, in nanoseconds per call.
+template <typename Func>
+static double benchmark(Func func) {
+	double best = -1;
+	for (int i = 0; i < TRIALS; i++) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (long j = 0; j < ITERATIONS; j++)
+			func();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		double time = elapsed.count() / ITERATIONS;
+		if (best < 0 || time < best)
+			best = time;
+	}
+	return best;
+}
+
+
+static void print(const char *name, double nanos) {
+	std::printf("%10.1f us  %8.0f /s  %s\n", nanos / 1000, 1e9 / nanos, name);
+}
+
+
+int main() {
+	const CurvePoint p = CurvePoint::privateExponentToPublicPoint(Uint256("41FAFE9B8AED4955413045F361506CC58C335DA64450788676844E8267179624"));
+	const CurvePoint q = CurvePoint::privateExponentToPublicPoint(Uint256("8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8"));
+	Uint256 n("C4A3D5E6F70819A2B3C4D5E6F70819A2B3C4D5E6F70819A2B3C4D5E6F70819A2");
+	Uint256 m("5E6F70819A2B3C4D5E6F70819A2B3C4D5E6F70819A2B3C4D5E6F70819A2B3C4D");
+	std::printf("WNAF_WINDOW_BITS = %d\n", WNAF_WINDOW_BITS);
+	
+	print("multiply (constant-time 4-bit window)", benchmark([&]() {
+		CurvePoint r = p;
+		r.multiply(n);
+		n.value[0] ^= r.x.value[0] & 1;  // Vary the scalar between calls
+	}));
+	print("multiplyVar (wNAF)", benchmark([&]() {
+		CurvePoint r = p;
+		r.multiplyVar(PublicScalar(n));
+		n.value[0] ^= r.x.value[0] & 1;
+	}));
+	print("multiplySumVar (wNAF, 2 terms)", benchmark([&]() {
+		const CurvePoint points[2] = {p, q};
+		const PublicScalar scalars[2] = {PublicScalar(n), PublicScalar(m)};
+		CurvePoint r = CurvePoint::multiplySumVar(scalars, points, 2);
+		n.value[0] ^= r.x.value[0] & 1;
+		m.value[1] ^= r.x.value[0] & 2;
+	}));
+	sink = n.value[0] ^ m.value[1];
+	return EXIT_SUCCESS;
+}
@@ -13,6 +13,10 @@
 #include <cstdlib>
 #include "CurvePoint.hpp"
 #include "FieldInt.hpp"
+#include "MultiplySumScratch.hpp"
+#include "PublicScalar.hpp"
+#include "Scalar.hpp"
+#include "Sha256.hpp"
 #include "Uint256.hpp"
 
 
@@ -258,6 +262,24 @@ static void testAdd() {
 			numTestCases++;
 		}
 	}
+	
+	// Add to and from an unnormalized zero, whose coordinates differ from ZERO
+	{
+		CurvePoint p = CurvePoint::G;
+		p.twice();
+		CurvePoint q = p;
+		q.negate();
+		p.add(q);
+		assert(p.isZero());
+		CurvePoint r = CurvePoint::G;
+		r.add(p);
+		r.normalize();
+		assert(r == CurvePoint::G);
+		p.add(CurvePoint::G);
+		p.normalize();
+		assert(p == CurvePoint::G);
+		numTestCases++;
+	}
 }
 
 
@@ -349,13 +371,108 @@ static void testMultiply() {
 		{"59B5E4509B28E1EA788C777C73337E4DC4F465C8772DAD204C8EE5FAFE2D4645", "51471C106EE9BC9E4D46ACF6409FA3C13787835080B2FE921BB2CCF9699636A9", "8272B678EB7E805A0725BC709E2BB2AEA7F10F3A53DAE3512D6DC8EEBF1D137B"},
 	};
 	for (const ThreeStrings &tc : cases) {
-		CurvePoint p = CurvePoint::G;
-		p.multiply(Uint256(tc.a));
+		for (int i = 0; i < 2; i++) {
+			CurvePoint p = CurvePoint::G;
+			if (i == 0)
+				p.multiply(Uint256(tc.a));
+			else
+				p.multiplyVar(PublicScalar(Uint256(tc.a)));
+			p.normalize();
+			if (tc.b == nullptr && tc.c == nullptr)
+				assert(p == CurvePoint::ZERO);
+			else
+				assert(p == CurvePoint(tc.b, tc.c));
+			numTestCases++;
+		}
+	}
+}
+
+
+static void testNegate() {
+	const vector<ThreeStrings> cases{
+		{"79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8", "B7C52588D95C3B9AA25B0403F1EEF75702E84BB7597AABE663B82F6F04EF2777"},
+		{"C6047F9441ED7D6D3045406E95C07CD85C778E4B8CEF3CA7ABAC09B95C709EE5", "1AE168FEA63DC339A3C58419466CEAEEF7F632653266D0E1236431A950CFE52A", "E51E970159C23CC65C3A7BE6B99315110809CD9ACD992F1EDC9BCE55AF301705"},
+		{"F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9", "388F7B0F632DE8140FE337E62A37F3566500A99934C2231B6CB9FD7584B8E672", "C77084F09CD217EBF01CC819D5C80CA99AFF5666CB3DDCE4934602897B4715BD"},
+		{"2A5BBCB0EEDE528E6ABE5F2EC50AD7887EB5677AF383A460B05EE23BF892DFE5", "52C93747550EDA8404C8B473786C00DFD8FD1EF4BC033F359CCF5B77BD656D21", "AD36C8B8AAF1257BFB374B8C8793FF202702E10B43FCC0CA6330A487429A8F0E"},
+		{"08822CF0E76F9FFB9ECE79DED3156DCC0B8AF68F996D99849DC3A1EB74E6D0B8", "6200BC425FE7FED7B5F52F3C195A7884E771849E3A13FC15C6E7F4581378C63C", "9DFF43BDA01801284A0AD0C3E6A5877B188E7B61C5EC03EA39180BA6EC8735F3"},
+	};
+	for (const ThreeStrings &tc : cases) {
+		CurvePoint p(tc.a, tc.b);
+		p.negate(0);
+		assert(p == CurvePoint(tc.a, tc.b));
+		p.negate(1);
+		assert(p == CurvePoint(tc.a, tc.c));
+		CurvePoint q = CurvePoint(tc.a, tc.b);
+		q.add(p);
+		assert(q.isZero());
+		numTestCases++;
+	}
+	CurvePoint z = CurvePoint::ZERO;
+	z.negate();
+	assert(z.isZero());
+	numTestCases++;
+}
+
+
+static void testMultiplyLambda() {
+	// Multiplying by LAMBDA is the same as multiplying the x coordinate by BETA
+	const vector<ThreeStrings> cases{
+		{"79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8", "BCACE2E99DA01887AB0102B696902325872844067F15E98DA7BBA04400B88FCB"},
+		{"C6047F9441ED7D6D3045406E95C07CD85C778E4B8CEF3CA7ABAC09B95C709EE5", "1AE168FEA63DC339A3C58419466CEAEEF7F632653266D0E1236431A950CFE52A", "C360A6D0B34CE6DF4135EE7D59F87B33D2FAD8CCE43837EF3E995B6ED89250E1"},
+		{"F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9", "388F7B0F632DE8140FE337E62A37F3566500A99934C2231B6CB9FD7584B8E672", "DF6EDF03731F9B4B8DCD8DCF2A28FA2F8AF1E022C6DC8E1CF7F0728C77206B2F"},
+		{"2A5BBCB0EEDE528E6ABE5F2EC50AD7887EB5677AF383A460B05EE23BF892DFE5", "52C93747550EDA8404C8B473786C00DFD8FD1EF4BC033F359CCF5B77BD656D21", "D6FDA2638BF1EDEB70731C0AD7821306DFA8232D7FB7C7870DE7D3454F139767"},
+		{"08822CF0E76F9FFB9ECE79DED3156DCC0B8AF68F996D99849DC3A1EB74E6D0B8", "6200BC425FE7FED7B5F52F3C195A7884E771849E3A13FC15C6E7F4581378C63C", "F2DC7FBF5CF857713EFB414BEBB9083AF4036BF6CD2D8F0814591DA959A8F6CD"},
+	};
+	for (const ThreeStrings &tc : cases) {
+		CurvePoint p(tc.a, tc.b);
+		p.multiply(Uint256(Scalar::LAMBDA));
 		p.normalize();
-		if (tc.b == nullptr && tc.c == nullptr)
-			assert(p == CurvePoint::ZERO);
+		assert(p == CurvePoint(tc.c, tc.b));
+		
+		CurvePoint q(tc.a, tc.b);
+		q.x.multiply(CurvePoint::BETA);
+		assert(q == CurvePoint(tc.c, tc.b));
+		numTestCases++;
+	}
+}
+
+
+static void testMultiplyAdd() {
+	struct MultiplyAddCase {
+		const char *u1;
+		const char *px;  // Null for zero point
+		const char *py;
+		const char *u2;
+		const char *qx;  // Null for zero point
+		const char *qy;
+		const char *rx;  // Null for zero point
+		const char *ry;
+	};
+	const vector<MultiplyAddCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8", "0000000000000000000000000000000000000000000000000000000000000000", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8", nullptr, nullptr},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8", "0000000000000000000000000000000000000000000000000000000000000001", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8", "C6047F9441ED7D6D3045406E95C07CD85C778E4B8CEF3CA7ABAC09B95C709EE5", "1AE168FEA63DC339A3C58419466CEAEEF7F632653266D0E1236431A950CFE52A"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8", nullptr, nullptr},
+		{"0000000000000000000000000000000000000000000000000000000000000005", "5CBDF0646E5DB4EAA398F365F2EA7A0E3D419B7E0330E39CE92BDDEDCAC4F9BC", "6AEBCA40BA255960A3178D6D861A54DBA813D0B813FDE7B5A5082628087264DA", "0000000000000000000000000000000000000000000000000000000000000000", "F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9", "388F7B0F632DE8140FE337E62A37F3566500A99934C2231B6CB9FD7584B8E672", "605BDB019981718B986D0F07E834CB0D9DEB8360FFB7F61DF982345EF27A7479", "02972D2DE4F8D20681A78D93EC96FE23C26BFAE84FB14DB43B01E1E9056B8C49"},
+		{"0000000000000000000000000000000000000000000000000000000000000000", "5CBDF0646E5DB4EAA398F365F2EA7A0E3D419B7E0330E39CE92BDDEDCAC4F9BC", "6AEBCA40BA255960A3178D6D861A54DBA813D0B813FDE7B5A5082628087264DA", "0000000000000000000000000000000000000000000000000000000000000009", "F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9", "388F7B0F632DE8140FE337E62A37F3566500A99934C2231B6CB9FD7584B8E672", "DAED4F2BE3A8BF278E70132FB0BEB7522F570E144BF615C07E996D443DEE8729", "A69DCE4A7D6C98E8D4A1ACA87EF8D7003F83C230F3AFA726AB40E52290BE1C55"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "C6047F9441ED7D6D3045406E95C07CD85C778E4B8CEF3CA7ABAC09B95C709EE5", "1AE168FEA63DC339A3C58419466CEAEEF7F632653266D0E1236431A950CFE52A", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9", "388F7B0F632DE8140FE337E62A37F3566500A99934C2231B6CB9FD7584B8E672", "2F8BDE4D1A07209355B4A7250A5C5128E88B84BDDC619AB7CBA8D569B240EFE4", "2753DDD9C91A1C292B24562259363BD90877D8E454F297BF235782C459539959"},
+		{"0000000000000000000000000000000000000000000000000000000000000003", "2F8BDE4D1A07209355B4A7250A5C5128E88B84BDDC619AB7CBA8D569B240EFE4", "D8AC222636E5E3D6D4DBA9DDA6C9C426F788271BAB0D6840DCA87D3AA6AC62D6", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364132", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8", nullptr, nullptr},
+		{"0000000000000000000000000000000000000000000000000000000000000005", nullptr, nullptr, "0000000000000000000000000000000000000000000000000000000000000009", "F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9", "388F7B0F632DE8140FE337E62A37F3566500A99934C2231B6CB9FD7584B8E672", "DAED4F2BE3A8BF278E70132FB0BEB7522F570E144BF615C07E996D443DEE8729", "A69DCE4A7D6C98E8D4A1ACA87EF8D7003F83C230F3AFA726AB40E52290BE1C55"},
+		{"00000000000008000008000000C0100030010000080000800000000804102200", "B1D0FFC2E34938A7B7A94E33037FFD561BCB518A6A45BAE5B42F2F3DE51ED38E", "16599C99B38BCC07CAC2F3C1298D827D5B8C35B6DD4B295E811E3538FCF04C31", "4008000000009000000000000000000080020000000000002000000000200000", "3EAE9B5450FA2CB2DB1C158C16920209F4EAE0BE8181619A81605F58830ED6E8", "81BE87A8A8B01C2AEB9905AA6E9CC9CA65D53F6A196F4312CAD63B7EDA908F17", "E028C5A879D34F3401F6A18CC4EE41D7A4B0B04464BD7CD96BE86EB84B8DFD8F", "8AB4AB8FE58FFC0A0F7E2657BF1021C7FDC82436285E5CB3F0CEADE494F72933"},
+		{"0000000002000000000002000200000000000000000000000002000000000800", "2666642677F75334EDD5CE6ACDA71FA6DAA5AF5F23C524E17BF9EB995B19532A", "3AABA5A3A0AC711714BD4FEB54ADFA8A02CCB3A14759D21850EE8FD30115F555", "0000000000008000000000001000004000000000020000000100000000000000", "6CD9DE254D4D99A7B822BBEBD241B5C3AD485957B0265A2660385275F458B7B2", "19BBEE7FAB04B24A8C9CEA0F85B4376628108F9C049B66953136FC2AF51F379F", "45382A76D7E18C2C346ECABA8AFE46D0960EDF123AE194CC8E62E28BB8AF4C31", "3DC8F76A9011F72F718070A8C8E2191F8987EA6CE83DD794512992FB49537B54"},
+		{"0DF51DA54048C30C63F0CE354D22F14D41BDD4911752AC0F6E8820AA7F679379", "3113F8AFBD45A6A03A36C583D0BD08D6E3872C99F104210490080C52DB0104EE", "47018BA95EFED37895B47DD294C0E4B467099151FE344FDB8785B4473B0DDA4E", "B7D56A5EE89B98BDD84C1DE48D444D8A11B5193A1D7016F5164587553D2AC67F", "320408E6E74CA36F213FC2E021AF3FFDA7791E4A93EAEB0AAF1F2E5EF1D4DC62", "BD3F6F41670D0F6C18264F5FD2B3D1844FB633055D9CE1F6114ED95E677BAD4D", "94B42A9551561BA98AE9DD36FEEDF58B8F99DB9B6F80E1BE8629E518AB974F33", "4CA7BFA8B1D30CE389E53D53D60085798935C5E7D0CBFCB05032ED5CECE7B54E"},
+		{"B360318356C7F81870FFCB2F4B3EBBF672783E91B4786B89138E561B606203A3", "173CB0D3317E0C59EF8AA1EF6EC7E1DB40208B77CC559022C223BF88A30408BC", "5C411F17A8DD044C0C6202C1B1584FFF1B8C4F595B22D87736656D3A1E038B2F", "2EE827ABFF69CABAA29B7D51B85A6C2F0EC946054C706D779E077E1A3F7A41DE", "5E895D483FA603243A82BD50D9C8A3599A3BE315889E2C0BBE607367B82C4351", "F97238F4BE57F7B89C3E766FD68FC58C91C6941A263A3A0AE642F553CAA930E9", "0EDB71836981A28F241E5191B13E51C103C436B9A5AA1699B548718D6205DBFD", "552DA9E8A075CC38732C284CF04E55F0BAFACE2585016A149BA542200143DF91"},
+		{"FFFFFFFFFDF9FEFFFFF5FFFFFFFFFDFFFFFFFFFFFF7FFFFFFFFFFBBF7FFFFFFF", "FF43B1F0372377ABFE16A2C4B42D375A8E414BD8B55FCB0D09FDD220FE7B6EA9", "E28D7CB72678137004B42C90AC1F613DB074659ED896403240026D94179B915D", "FFFFFFFFFFFFFFFBFFEFFFFFFFFFFFFEEFFFFFFDEFFFFFFFFFFFFFEFFBFEFFFF", "2B666174FB96A2678C02A45E120A99192C109CAF150FB771F0E6FCC509EF8B0B", "F9A200AF48DA63F6BB9049D8D79B32E1C8CF90BDCD712FC610360A42BBF19FC5", "0F89DE3FE69110949DD355775FA51809077F88BCA7EC4D2BCB74B41DDDFBC7A7", "E5AF2649BFCD10B44A543987C0BB412291C1D6D29073EF994D02E5F8C6C3D6A7"},
+		{"FFFFFFFFBFFFFFFFFFF5FFFFFFFFFBFFFEFFFFEFFEFFFFFFFFFFFFFFFFFBFFFF", "D42B4FDC38D7CC40691B737786CEC9990836AA3937C3D23BD80A1A578E59035A", "AF4B49640FCD973ED9B50996D031814AE7649CFECCAB9DEB2E7F05C541561847", "FFFEFFFFFFFFFFFFFFFFFFFFFFFFFFFBFFFFFFFFFFFFFFFFBFFFFFFFFEFFBFFF", "8B39A7912EDD675CDEBEA2EBAADAB9F4A65AEBA3D9B4C97C794FBDFC8839292B", "02AEBDD68A7E1DBABFA6F62BB67E452D616342C6D83586CF85232416305B3712", "09CFE42E348404DC699BA2442BC1589557A1668066572E965C51071B9E90DC97", "C60376E16C489B7697863E0BEDDB6990712C9C2747D1A955DA78ABD50CD3D881"},
+	};
+	for (const MultiplyAddCase &tc : cases) {
+		const CurvePoint p = tc.px != nullptr ? CurvePoint(tc.px, tc.py) : CurvePoint::ZERO;
+		const CurvePoint q = tc.qx != nullptr ? CurvePoint(tc.qx, tc.qy) : CurvePoint::ZERO;
+		CurvePoint r = CurvePoint::multiplyAdd(Uint256(tc.u1), p, Uint256(tc.u2), q);
+		r.normalize();
+		if (tc.rx == nullptr)
+			assert(r == CurvePoint::ZERO);
 		else
-			assert(p == CurvePoint(tc.b, tc.c));
+			assert(r == CurvePoint(tc.rx, tc.ry));
 		numTestCases++;
 	}
 }
@@ -1098,6 +1215,183 @@ static void testIsOnCurve() {
 }
 
 
+static void testMultiplyGenerator() {
+	const vector<ThreeStrings> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000000", nullptr, nullptr},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8"},
+		{"0000000000000000000000000000000000000000000000000000000000000002", "C6047F9441ED7D6D3045406E95C07CD85C778E4B8CEF3CA7ABAC09B95C709EE5", "1AE168FEA63DC339A3C58419466CEAEEF7F632653266D0E1236431A950CFE52A"},
+		{"000000000000000000000000000000000000000000000000000000000000000F", "D7924D4F7D43EA965A465AE3095FF41131E5946F3C85F79E44ADBCF8E27E080E", "581E2872A86C72A683842EC228CC6DEFEA40AF2BD896D3A5C504DC9FF6A26B58"},
+		{"0000000000000000000000000000000000000000000000000000000000000010", "E60FCE93B59E9EC53011AABC21C23E97B2A31369B87A5AE9C44EE89E2A6DEC0A", "F7E3507399E595929DB99F34F57937101296891E44D23F0BE1F32CCE69616821"},
+		{"0000000000000000000000000000000000000000000000000000000010000000", "EEBFA4D493BEBF98BA5FEEC812C2D3B50947961237A919839A533ECA0E7DD7FA", "5D9A8CA3970EF0F269EE7EDAF178089D9AE4CDC3A711F712DDFD4FDAE1DE8999"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "B7C52588D95C3B9AA25B0403F1EEF75702E84BB7597AABE663B82F6F04EF2777"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141", nullptr, nullptr},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364142", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "9166C289B9F905E55F9E3DF9F69D7F356B4A22095F894F4715714AA4B56606AF", "F181EB966BE4ACB5CFF9E16B66D809BE94E214F06C93FD091099AF98499255E7"},
+		{"8888888888888888888888888888888888888888888888888888888888888888", "1617D38ED8D8657DA4D4761E8057BC396EA9E4B9D29776D4BE096016DBD2509B", "44EFD9E573FBD9C340E2A1F432C08FF1261C82873415F347AAD6FE32CE5FFA48"},
+		{"F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0", "9E5F7DBE6D62ADE5AAB476B40559852EA1B5FC7BB99A61A42EAB550F69FFAFB4", "1015941608ACE443077512FDBAEB52B7E9C239121EE4ABD7A6CAEFC7A0C0B72F"},
+		{"0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F", "1A7A569E91DBF60581509C7FC946D1003B60C7DEE85299538DB6353538D59574", "B4E89D60C7D584D084632D296F125F165B4DF8E061A49DAEBA51D36133D03E1A"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "B23790A42BE63E1B251AD6C94FDEF07271EC0AADA31DB6C3E8BD32043F8BE384", "FC6B694919D55EDBE8D50F88AA81F94517F004F4149ECB58D10A473DEB19880E"},
+		{"F000000000000000000000000000000000000000000000000000000000000000", "3BC6BC6446BF520136358EB0958DC4AA9E733164DD2D62E151F946107427BACC", "8E305CC07176C305CDB62EE226D6C02BD71B75A5228BEB4714C33FD5EAD6FDA6"},
+		{"0000080000041000000004000010000000001400000000000000000020200000", "968A629FEB4A1C660F1025BE58A2DC2B4BC388BFDA24F9758FD9AA682D7BD9E4", "7E7887F4F60E32CBE61D1D6FEBDAA30D3163092A02E435974BF583CA65D75B2A"},
+		{"0000000000000200000000000000000000040008020000041000002000000000", "38C6B4D5A0D4F1F6285990B04BD0D74B2CE3CE8E92E6793ED248F7769ACCB685", "8A939A39B8E577ADC735120AEAC13BD5E77E17E994ECFF42BD8DFF206D39999E"},
+		{"B2160535D43F02A4FB5C13236BBDB09BFE25AAC9C4E18344C7E607FC1AD2FB16", "8CCBDE78223EE552A487396DC659994B445829FD9C82AC0F89DF4C566A0D1B5D", "6462987907EB542CEE20AB838279593A3987A8AFE3AB3978A89C72C6B237F78C"},
+		{"9C43481D06F763D2D5DB07E29931A0EFAD2F0499A2482454187E1D18F4AFA9A1", "6EA8715DDF474840904DB1875583CB9429D4BD831E581CAA78E8A8349C756DCF", "C85F3ACF74C32C47E12078CA2FDD006930CEF33BC55B94FDCC707407EE0E4169"},
+		{"BFEFFFFFFFFFFFFFFFEFFFFFBFFFFFEFFFFAFFFFFBFFFFFFFFFFFFFFFFFFFFFF", "54E7857414AD5601727FA74B310ED533D49F5503E8A9BC24BAB71EDEFA1677ED", "798AFDD14F251733AD6513C06181DE6DE0C1D04BE173434C0DDA0A1076C207F7"},
+		{"FFDFFFFFFFFFFFFFFFFFBFFFFFFFFFFFFFFFBFFFFFFF7FFFDFFFFFFFFFFFFFFF", "79C105563D6EB38018F8AFD5C34AF23E09DEED7FA8997ED31BD18A29A9B0046F", "FD427A8F759EBEE0D8205B4253DF563DD75CC6BBF5E3F238A8A3BC0E6880FDAD"},
+	};
+	for (const ThreeStrings &tc : cases) {
+		for (int i = 0; i < 2; i++) {
+			CurvePoint p = i == 0 ? CurvePoint::multiplyGenerator(Uint256(tc.a))
+				: CurvePoint::multiplyGeneratorVar(PublicScalar(Uint256(tc.a)));
+			p.normalize();
+			if (tc.b == nullptr && tc.c == nullptr)
+				assert(p == CurvePoint::ZERO);
+			else
+				assert(p == CurvePoint(tc.b, tc.c));
+			numTestCases++;
+		}
+	}
+}
+
+
+static void testMultiplySumVar() {
+	const vector<const char *> scalarStrs{
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"000000000000000000000000000000000000000000000000000000000000000F",
+		"00000000000000000000000000000000B2160535D43F02A4FB5C13236BBDB09B",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+		"9C43481D06F763D2D5DB07E29931A0EFAD2F0499A2482454187E1D18F4AFA9A1",
+		"0000080000041000000004000010000000001400000000000000000020200000",
+	};
+	vector<PublicScalar> scalars;
+	vector<CurvePoint> points;
+	for (size_t i = 0; i < scalarStrs.size(); i++) {
+		scalars.push_back(PublicScalar(Uint256(scalarStrs.at(i))));
+		CurvePoint p = CurvePoint::G;
+		p.multiply(Uint256(scalarStrs.at(scalarStrs.size() - 1 - i)));
+		p.normalize();
+		points.push_back(p);
+	}
+	points.at(3) = points.at(2);  // Repeated point
+	
+	// Compare every prefix of the lists against separate multiplications
+	CurvePoint expect = CurvePoint::ZERO;
+	for (size_t len = 0; len <= scalars.size(); len++) {
+		if (len > 0) {
+			CurvePoint temp = points.at(len - 1);
+			temp.multiply(scalars.at(len - 1).getValue());
+			expect.add(temp);
+		}
+		CurvePoint actual = CurvePoint::multiplySumVar(scalars.data(), points.data(), len);
+		actual.normalize();
+		CurvePoint temp = expect;
+		temp.normalize();
+		assert(actual == temp);
+		numTestCases++;
+	}
+}
+
+
+static void testMultiplySumVarScratch() {
+	// Terms with pseudorandom scalars and points, plus scalars 0, 1 and -1, a zero point, repeated terms
+	// (equal points in a bucket) and opposite terms (points in a bucket that cancel)
+	constexpr size_t maxLen = 600;
+	vector<PublicScalar> scalars;
+	vector<CurvePoint> points;
+	CurvePoint p = CurvePoint::G;
+	for (size_t i = 0; i < maxLen; i++) {
+		const std::uint8_t msg[2] = {static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(i >> 8)};
+		Uint256 k(Sha256::getHash(msg, sizeof(msg)).value);
+		if (i % 5 == 1) {  // Below 2^128, so not split
+			for (int j = 4; j < Uint256::NUM_WORDS; j++)
+				k.value[j] = 0;
+		}
+		scalars.push_back(PublicScalar(Scalar(k)));
+		p.add(CurvePoint::G);
+		p.twice();
+		points.push_back(p);
+	}
+	scalars.at(0) = PublicScalar(Uint256::ZERO);
+	scalars.at(2) = PublicScalar(Uint256::ONE);
+	scalars.at(3) = PublicScalar(Uint256("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"));
+	points.at(4) = CurvePoint::ZERO;
+	for (size_t i = 100; i < 110; i++) {
+		scalars.at(i) = scalars.at(99);
+		points.at(i) = points.at(99);
+	}
+	for (size_t i = 110; i < 120; i += 2) {
+		points.at(i + 1) = points.at(i);
+		points.at(i + 1).negate();
+		scalars.at(i + 1) = scalars.at(i);
+	}
+	
+	for (unsigned int numThreads : {1u, 3u}) {
+		MultiplySumScratch scratch(maxLen, numThreads);
+		MultiplySumScratch smallScratch(MultiplySumScratch::STRAUSS_MAX_LEN + 1, numThreads);
+		for (size_t len : {0, 1, 2, 64, 65, 66, 200, 600}) {
+			CurvePoint expect = CurvePoint::multiplySumVar(scalars.data(), points.data(), len);
+			expect.normalize();
+			CurvePoint actual = CurvePoint::multiplySumVar(scalars.data(), points.data(), len, scratch);
+			actual.normalize();
+			assert(actual == expect);
+			if (len <= smallScratch.getMaxLen()) {
+				actual = CurvePoint::multiplySumVar(scalars.data(), points.data(), len, smallScratch);
+				actual.normalize();
+				assert(actual == expect);
+			}
+			numTestCases++;
+		}
+		
+		// Every term in the same bucket of every window
+		vector<PublicScalar> ones(maxLen, PublicScalar(Uint256::ONE));
+		vector<CurvePoint> gs(maxLen, CurvePoint::G);
+		CurvePoint actual = CurvePoint::multiplySumVar(ones.data(), gs.data(), maxLen, scratch);
+		actual.normalize();
+		assert(actual == CurvePoint::privateExponentToPublicPoint(Uint256("0000000000000000000000000000000000000000000000000000000000000258")));
+		numTestCases++;
+	}
+}
+
+
+static void testNormalizeBatch() {
+	// Unnormalized points, including zeros with and without ZERO's exact coordinates
+	vector<CurvePoint> points;
+	CurvePoint p = CurvePoint::G;
+	for (int i = 0; i < 6; i++) {
+		p.twice();
+		p.add(CurvePoint::G);
+		points.push_back(p);
+	}
+	CurvePoint zero = points.at(2);
+	CurvePoint neg = zero;
+	neg.negate();
+	zero.add(neg);
+	assert(zero.isZero() && !(zero == CurvePoint::ZERO));
+	points.insert(points.begin(), CurvePoint::ZERO);
+	points.insert(points.begin() + 3, zero);
+	points.push_back(zero);
+	points.push_back(CurvePoint::G);
+	
+	for (size_t len = 0; len <= points.size(); len++) {
+		for (int i = 0; i < 2; i++) {
+			vector<CurvePoint> actual(points.begin(), points.begin() + len);
+			if (i == 0)
+				CurvePoint::normalizeBatch(actual.data(), len);
+			else
+				CurvePoint::normalizeBatchVar(actual.data(), len);
+			for (size_t j = 0; j < len; j++) {
+				CurvePoint expect = points.at(j);
+				expect.normalize();
+				assert(actual.at(j) == expect);
+			}
+			numTestCases++;
+		}
+	}
+}
+
+
 static void testPrivateExponentToPublicPoint() {
 	const vector<ThreeStrings> cases{
 		{"0000000000000000000000000000000000000000000000000000000000000001", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8"},
@@ -1119,14 +1413,112 @@ static void testPrivateExponentToPublicPoint() {
 }
 
 
+static void testFromCompressedAndUncompressedPoint() {
+	// Round trips of points with both parities of y
+	const vector<const char *> privateKeys{
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"0000000000000000000000000000000000000000000000000000000000000002",
+		"000000000000000000000000000000000000000000000000000000000000000F",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413E",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+	};
+	for (const char *privateKey : privateKeys) {
+		const CurvePoint p = CurvePoint::privateExponentToPublicPoint(Uint256(privateKey));
+		std::uint8_t compressed[33];
+		p.toCompressedPoint(compressed);
+		CurvePoint q = CurvePoint::ZERO;
+		assert(CurvePoint::fromCompressedPoint(compressed, q) && q == p);
+		q = CurvePoint::ZERO;
+		assert(CurvePoint::fromCompressedPointVar(compressed, q) && q == p);
+		
+		std::uint8_t uncompressed[65];
+		uncompressed[0] = 0x04;
+		p.x.getBigEndianBytes(&uncompressed[1]);
+		p.y.getBigEndianBytes(&uncompressed[33]);
+		q = CurvePoint::ZERO;
+		assert(CurvePoint::fromUncompressedPoint(uncompressed, q) && q == p);
+		
+		// Bad header bytes, and a y coordinate that is off the curve
+		compressed[0] = 0x04;
+		assert(!CurvePoint::fromCompressedPoint(compressed, q));
+		assert(!CurvePoint::fromCompressedPointVar(compressed, q));
+		uncompressed[0] = 0x06 + (p.y.value[0] & 1);  // Hybrid format, not accepted
+		assert(!CurvePoint::fromUncompressedPoint(uncompressed, q));
+		uncompressed[0] = 0x04;
+		uncompressed[64] ^= 1;
+		assert(!CurvePoint::fromUncompressedPoint(uncompressed, q));
+		numTestCases++;
+	}
+	
+	// Invalid x coordinates: not on the curve (x^3 + 7 is not a square), or not less than the modulus
+	const vector<const char *> badCompressed{
+		"020000000000000000000000000000000000000000000000000000000000000000",
+		"030000000000000000000000000000000000000000000000000000000000000005",
+		"02FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F",
+		"03FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+	};
+	for (const char *tc : badCompressed) {
+		CurvePoint q = CurvePoint::ZERO;
+		assert(!CurvePoint::fromCompressedPoint(hexBytes(tc).data(), q) && q == CurvePoint::ZERO);
+		assert(!CurvePoint::fromCompressedPointVar(hexBytes(tc).data(), q) && q == CurvePoint::ZERO);
+		numTestCases++;
+	}
+	
+	// The point (1, y) is on the curve, but these encodings use x = 1 + modulus
+	const Bytes overflowX = hexBytes("04"
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC30"
+		"4218F20AE6C646B363DB68605822FB14264CA8D2587FDD6FBC750D587E76A7EE");
+	CurvePoint q = CurvePoint::ZERO;
+	assert(!CurvePoint::fromUncompressedPoint(overflowX.data(), q));
+	assert(!CurvePoint::fromCompressedPoint(hexBytes("02FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC30").data(), q));
+	assert(!CurvePoint::fromCompressedPointVar(hexBytes("02FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC30").data(), q));
+	Bytes valid = overflowX;
+	valid.at(1) = 0;
+	for (int i = 2; i < 32; i++)
+		valid.at(i) = 0;
+	valid.at(32) = 1;
+	assert(CurvePoint::fromUncompressedPoint(valid.data(), q));
+	numTestCases++;
+}
+
+
+static void testToEthereumAddress() {
+	struct AddressCase {
+		const char *privateKey;
+		const char *address;
+	};
+	const vector<AddressCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000001", "7e5f4552091a69125d5dfcb7b8c2659029395bdf"},
+		{"0000000000000000000000000000000000000000000000000000000000000002", "2b5ad5c4795c026514f8317c7a215e218dccd6cf"},
+		{"0000000000000000000000000000000000000000000000000000000000000003", "6813eb9362372eef6200f3b1dbc3f819671cba69"},
+	};
+	for (const AddressCase &tc : cases) {
+		CurvePoint p = CurvePoint::privateExponentToPublicPoint(Uint256(tc.privateKey));
+		std::uint8_t address[20];
+		p.toEthereumAddress(address);
+		assert(Bytes(address, address + sizeof(address)) == hexBytes(tc.address));
+		numTestCases++;
+	}
+}
+
+
 int main() {
 	testReplace();
 	testTwice();
 	testAdd();
 	testMultiply();
+	testNegate();
+	testMultiplyLambda();
+	testMultiplyAdd();
 	testMultiplyModOrder();
 	testIsOnCurve();
+	testMultiplyGenerator();
+	testMultiplySumVar();
+	testMultiplySumVarScratch();
+	testNormalizeBatch();
 	testPrivateExponentToPublicPoint();
+	testFromCompressedAndUncompressedPoint();
+	testToEthereumAddress();
 	std::printf("All %d test cases passed\n", numTestCases);
 	return EXIT_SUCCESS;
 }
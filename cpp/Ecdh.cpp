@@ -0,0 +1,64 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include "CountOps.hpp"
+#include "Ecdh.hpp"
+#include "FieldInt.hpp"
+#include "Sha256.hpp"
+
+using std::uint8_t;
+
+
+bool Ecdh::sharedSecret(const Uint256 &privateKey, const PublicKey &peerPublicKey, uint8_t outSecret[SECRET_LEN]) {
+	countOps(functionOps);
+	assert(outSecret != nullptr);
+	CurvePoint p = CurvePoint::ZERO;
+	if (!multiplyPeer(privateKey, peerPublicKey, p))
+		return false;
+	
+	// Normalize only x, which saves the multiplication for y
+	FieldInt x = p.z;
+	x.reciprocal();
+	x.multiply(p.x);
+	x.getBigEndianBytes(outSecret);
+	countOps(1 * curvepointCopyOps);
+	countOps(1 * fieldintCopyOps);
+	return true;
+}
+
+
+bool Ecdh::sharedSecretSha256(const Uint256 &privateKey, const PublicKey &peerPublicKey, Sha256Hash &outHash) {
+	countOps(functionOps);
+	CurvePoint p = CurvePoint::ZERO;
+	if (!multiplyPeer(privateKey, peerPublicKey, p))
+		return false;
+	p.normalize();
+	uint8_t compressed[33];
+	p.toCompressedPoint(compressed);
+	outHash = Sha256::getHash(compressed, sizeof(compressed));
+	countOps(1 * curvepointCopyOps);
+	return true;
+}
+
+
+bool Ecdh::multiplyPeer(const Uint256 &privateKey, const PublicKey &peerPublicKey, CurvePoint &outPoint) {
+	/* 
+	 * The multiplication is the constant-time GLV path of CurvePoint::multiply(). Because the curve has prime
+	 * order and the peer point is valid (not zero), the product of a private key in range is never zero.
+	 */
+	countOps(functionOps);
+	if (!peerPublicKey.isValid() || privateKey == Uint256::ZERO || privateKey >= CurvePoint::ORDER)
+		return false;
+	outPoint = peerPublicKey.getPoint();
+	outPoint.multiply(privateKey);
+	assert(!outPoint.isZero());
+	countOps(3 * arithmeticOps);
+	countOps(1 * curvepointCopyOps);
+	return true;
+}
@@ -0,0 +1,48 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "CurvePoint.hpp"
+#include "PublicKey.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+
+/* 
+ * Computes elliptic curve Diffie-Hellman shared secrets on secp256k1. The peer's public key is
+ * passed as a PublicKey, so it is validated once when that object is constructed and not again
+ * for every secret derived from it. Provides just a few static functions.
+ */
+class Ecdh final {
+	
+	public: static constexpr int SECRET_LEN = 32;
+	
+	
+	// Computes the x coordinate (in big-endian) of privateKey * peerPublicKey. Returns true if successful,
+	// or false if the peer key is invalid or privateKey is outside the range [1, CurvePoint::ORDER);
+	// outSecret is assigned iff successful. Only the x coordinate is normalized. All successful executions
+	// are constant-time with respect to the private key.
+	public: static bool sharedSecret(const Uint256 &privateKey, const PublicKey &peerPublicKey, std::uint8_t outSecret[SECRET_LEN]);
+	
+	
+	// Computes the SHA-256 hash of privateKey * peerPublicKey in compressed format (header byte, then x),
+	// which is the default ECDH output of libsecp256k1. Returns true if successful, with the same conditions
+	// and constant-time behavior as sharedSecret(); outHash is assigned iff successful.
+	public: static bool sharedSecretSha256(const Uint256 &privateKey, const PublicKey &peerPublicKey, Sha256Hash &outHash);
+	
+	
+	// Sets outPoint to privateKey * peerPublicKey (not normalized) if the inputs are valid, returning whether
+	// they are. Constant-time with respect to the private key.
+	private: static bool multiplyPeer(const Uint256 &privateKey, const PublicKey &peerPublicKey, CurvePoint &outPoint);
+	
+	
+	Ecdh() = delete;  // Not instantiable
+	
+};
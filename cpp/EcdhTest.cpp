@@ -0,0 +1,109 @@
+/* 
+ * A runnable main program that tests the functionality of class Ecdh.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "TestHelper.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "CurvePoint.hpp"
+#include "Ecdh.hpp"
+#include "FieldInt.hpp"
+#include "PublicKey.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+
+// Global variables
+static int numTestCases = 0;
+
+
+/*---- Test cases ----*/
+
+static void testSharedSecret() {
+	struct SecretCase {
+		const char *privateKey;
+		const char *peerX;
+		const char *peerY;
+		const char *expectedSecret;
+		const char *expectedHash;  // SHA-256 of the compressed point, in natural byte order
+	};
+	const vector<SecretCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000001", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8", "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "0F715BAF5D4C2ED329785CEF29E562F73488C8A2BB9DBC5700B361D54B9B0554"},
+		{"0000000000000000000000000000000000000000000000000000000000000002", "F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9", "388F7B0F632DE8140FE337E62A37F3566500A99934C2231B6CB9FD7584B8E672", "FFF97BD5755EEEA420453A14355235D382F6472F8568A18B2F057A1460297556", "C7D9BA2FA1496C81BE20038E5C608F2FD5D0246D8643783730DF6C2BBB855CB2"},
+		{"8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8", "0894452F683B4E50E6A242CF069524247CED22AD04B486A0F914A42CDA8BAF38", "75BA60529016CA70200C530E2100BA01DDED3FA5478712607699A50A527465CA", "B2EC698B0742EF578CDDF25BB2FAAF6FECC0DD85D22B41A9E6519DA5BF916F1E", "10C149B5560B72BE3AD6F7267640E63DE9416EEBAB5C81B2B083F211C354DC58"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "016CEC28DC0D88A08F162931B021ED6ECBE1F3124690C66FD1DC935C0690B42B", "C59BAD6F95516C83B61E049F21492DB6656C0BA0253880FFBCC8CEC707568B04", "016CEC28DC0D88A08F162931B021ED6ECBE1F3124690C66FD1DC935C0690B42B", "18D28C903F3A7EDCA8E900FDDB2600417F26E4AE20F476F9A0C9B0DF5118A3FA"},
+	};
+	for (const SecretCase &tc : cases) {
+		const Uint256 privateKey(tc.privateKey);
+		const PublicKey peer(CurvePoint(FieldInt(tc.peerX), FieldInt(tc.peerY)));
+		assert(peer.isValid());
+		
+		std::uint8_t secret[Ecdh::SECRET_LEN];
+		assert(Ecdh::sharedSecret(privateKey, peer, secret));
+		assert(Bytes(secret, secret + sizeof(secret)) == hexBytes(tc.expectedSecret));
+		
+		Sha256Hash hash("0000000000000000000000000000000000000000000000000000000000000000");
+		assert(Ecdh::sharedSecretSha256(privateKey, peer, hash));
+		assert(Bytes(hash.value, hash.value + Sha256Hash::HASH_LEN) == hexBytes(tc.expectedHash));
+		numTestCases++;
+	}
+}
+
+
+static void testSymmetry() {
+	const vector<const char *> privateKeys{
+		"0000000000000000000000000000000000000000000000000000000000000003",
+		"0000000000000000000000000000000000000000000000000000000000000123",
+		"41FAFE9B8AED4955413045F361506CC58C335DA64450788676844E8267179624",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F",
+	};
+	for (const char *a : privateKeys) {
+		for (const char *b : privateKeys) {
+			const Uint256 privA(a);
+			const Uint256 privB(b);
+			const PublicKey pubA(CurvePoint::privateExponentToPublicPoint(privA));
+			const PublicKey pubB(CurvePoint::privateExponentToPublicPoint(privB));
+			std::uint8_t secretAb[Ecdh::SECRET_LEN];
+			std::uint8_t secretBa[Ecdh::SECRET_LEN];
+			assert(Ecdh::sharedSecret(privA, pubB, secretAb));
+			assert(Ecdh::sharedSecret(privB, pubA, secretBa));
+			assert(Bytes(secretAb, secretAb + sizeof(secretAb)) == Bytes(secretBa, secretBa + sizeof(secretBa)));
+			numTestCases++;
+		}
+	}
+}
+
+
+static void testInvalid() {
+	const PublicKey valid(CurvePoint::G);
+	CurvePoint offCurve = CurvePoint::G;
+	offCurve.y.add(CurvePoint::FI_ONE);
+	const PublicKey invalid(offCurve);
+	std::uint8_t secret[Ecdh::SECRET_LEN] = {};
+	Sha256Hash hash("0000000000000000000000000000000000000000000000000000000000000000");
+	
+	assert(!Ecdh::sharedSecret(Uint256::ONE, invalid, secret));
+	assert(!Ecdh::sharedSecret(Uint256::ONE, PublicKey(CurvePoint::ZERO), secret));
+	assert(!Ecdh::sharedSecret(Uint256::ZERO, valid, secret));
+	assert(!Ecdh::sharedSecret(CurvePoint::ORDER, valid, secret));
+	assert(!Ecdh::sharedSecretSha256(Uint256::ONE, invalid, hash));
+	assert(!Ecdh::sharedSecretSha256(Uint256::ZERO, valid, hash));
+	assert(Bytes(secret, secret + sizeof(secret)) == Bytes(sizeof(secret), 0));  // Not assigned
+	numTestCases += 6;
+}
+
+
+int main() {
+	testSharedSecret();
+	testSymmetry();
+	testInvalid();
+	std::printf("All %d test cases passed\n", numTestCases);
+	return EXIT_SUCCESS;
+}
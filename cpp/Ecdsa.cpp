@@ -6,12 +6,18 @@
  * https://github.com/nayuki/Bitcoin-Cryptography-Library
  */
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <thread>
+#include <vector>
 #include "CountOps.hpp"
 #include "Ecdsa.hpp"
 #include "FieldInt.hpp"
+#include "PublicScalar.hpp"
+#include "Scalar.hpp"
 #include "Sha256.hpp"
 
 using std::uint8_t;
@@ -19,6 +25,74 @@ using std::uint32_t;
 
 
 bool Ecdsa::sign(const Uint256 &privateKey, const Sha256Hash &msgHash, const Uint256 &nonce, Uint256 &outR, Uint256 &outS) {
+	uint8_t recid;
+	return signRecoverable(privateKey, msgHash, nonce, outR, outS, recid);
+}
+
+
+bool Ecdsa::signWithHmacNonce(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS) {
+	return sign(privateKey, msgHash, getHmacNonce(privateKey, msgHash), outR, outS);
+}
+
+
+bool Ecdsa::signWithRfc6979Nonce(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS) {
+	if (privateKey == Uint256::ZERO || privateKey >= CurvePoint::ORDER)
+		return false;
+	Rfc6979 gen(privateKey, msgHash);
+	signWithGenerator(privateKey, msgHash, gen, outR, outS);
+	return true;
+}
+
+
+bool Ecdsa::signWithRfc6979Nonce(const Uint256 &privateKey, const Sha256Hash &msgHash,
+		const uint8_t extraEntropy[32], Uint256 &outR, Uint256 &outS) {
+	assert(extraEntropy != nullptr);
+	if (privateKey == Uint256::ZERO || privateKey >= CurvePoint::ORDER)
+		return false;
+	Rfc6979 gen(privateKey, msgHash, extraEntropy);
+	signWithGenerator(privateKey, msgHash, gen, outR, outS);
+	return true;
+}
+
+
+bool Ecdsa::signBatch(const Uint256 privateKeys[], const Sha256Hash msgHashes[], std::size_t len,
+		Uint256 outR[], Uint256 outS[], unsigned int numThreads, std::size_t &outFailIndex) {
+	countOps(functionOps);
+	if (numThreads == 0)
+		numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	std::size_t chunkLen = (len + numThreads - 1) / numThreads;
+	std::vector<uint8_t> ok(len, 0);
+	if (numThreads == 1 || len <= 1)
+		signChunk(privateKeys, msgHashes, len, outR, outS, ok.data());
+	else {
+		// Each thread writes only its own contiguous range of the outputs, so the order is deterministic
+		std::vector<std::thread> threads;
+		try {
+			for (std::size_t start = 0; start < len; start += chunkLen) {
+				std::size_t n = std::min(chunkLen, len - start);
+				threads.emplace_back(signChunk, &privateKeys[start], &msgHashes[start], n, &outR[start], &outS[start], &ok[start]);
+			}
+		} catch (...) {
+			// Destroying a joinable thread would call std::terminate(), so wait for the started ones first
+			for (std::thread &th : threads)
+				th.join();
+			throw;
+		}
+		for (std::thread &th : threads)
+			th.join();
+	}
+	for (std::size_t i = 0; i < len; i++) {
+		if (ok[i] == 0) {
+			outFailIndex = i;
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool Ecdsa::signRecoverable(const Uint256 &privateKey, const Sha256Hash &msgHash, const Uint256 &nonce,
+		Uint256 &outR, Uint256 &outS, uint8_t &outRecid) {
 	/* 
 	 * Algorithm pseudocode:
 	 * if (nonce outside range [1, order-1]) return false
@@ -27,7 +101,9 @@ bool Ecdsa::sign(const Uint256 &privateKey, const Sha256Hash &msgHash, const Uin
 	 * if (r == 0) return false
 	 * s = nonce^-1 * (msgHash + r * privateKey) % order
 	 * if (s == 0) return false
-	 * s = min(s, order - s)
+	 * recid = (p.y % 2) + (p.x >= order ? 2 : 0)
+	 * if (order - s < s)
+	 *   s = order - s, recid = recid XOR 1
 	 */
 	countOps(functionOps);
 	
@@ -39,93 +115,155 @@ bool Ecdsa::sign(const Uint256 &privateKey, const Sha256Hash &msgHash, const Uin
 	
 	const CurvePoint p = CurvePoint::privateExponentToPublicPoint(nonce);
 	Uint256 r(p.x);
-	r.subtract(order, static_cast<uint32_t>(r >= order));
+	uint32_t xOverflow = static_cast<uint32_t>(r >= order);
+	r.subtract(order, xOverflow);
 	if (r == zero)
 		return false;
 	assert(r < order);
-	countOps(1 * arithmeticOps);
+	countOps(2 * arithmeticOps);
 	countOps(1 * uint256CopyOps);
 	countOps(1 * curvepointCopyOps);
 	
-	Uint256 s = r;
-	const Uint256 z(msgHash.value);
-	multiplyModOrder(s, privateKey);
-	uint32_t carry = s.add(z);
-	s.subtract(order, carry | static_cast<uint32_t>(s >= order));
-	countOps(1 * arithmeticOps);
-	countOps(2 * uint256CopyOps);
+	Scalar s(r);
+	s.multiply(Scalar(privateKey));
+	s.add(Scalar(Uint256(msgHash.value)));
+	countOps(3 * uint256CopyOps);
 	
-	Uint256 kInv = nonce;
-	kInv.reciprocal(order);
-	multiplyModOrder(s, kInv);
-	if (s == zero)
+	Scalar kInv(nonce);
+	kInv.reciprocal();
+	s.multiply(kInv);
+	if (s == Scalar(zero))
 		return false;
-	countOps(1 * arithmeticOps);
-	countOps(1 * uint256CopyOps);
+	countOps(2 * uint256CopyOps);
 	
-	Uint256 negS = order;
-	negS.subtract(s);
-	s.replace(negS, static_cast<uint32_t>(negS < s));  // To ensure low S values for BIP 62
+	Scalar negS = s;
+	negS.negate();
+	uint32_t isHigh = static_cast<uint32_t>(negS < s);
+	s.replace(negS, isHigh);  // To ensure low S values for BIP 62; this negates the nonce point
 	outR = r;
-	outS = s;
+	outS = Uint256(s);
+	outRecid = static_cast<uint8_t>(((p.y.value[0] & 1) ^ isHigh) | (xOverflow << 1));
 	countOps(3 * uint256CopyOps);
+	countOps(3 * arithmeticOps);
 	return true;
 }
 
 
-bool Ecdsa::signWithHmacNonce(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS) {
-	uint8_t privkeyBytes[Uint256::NUM_WORDS * 4];
-	privateKey.getBigEndianBytes(privkeyBytes);
-	const Sha256Hash hmac = Sha256::getHmac(privkeyBytes, sizeof(privkeyBytes), msgHash.value, Sha256Hash::HASH_LEN);
-	const Uint256 nonce(hmac.value);
-	return sign(privateKey, msgHash, nonce, outR, outS);
+bool Ecdsa::recover(const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s, uint8_t recid, CurvePoint &outPublicKey) {
+	/* 
+	 * Algorithm pseudocode:
+	 * if (!(0 < r, s < order) || recid > 3)
+	 *   return false
+	 * x = r + (recid >= 2 ? order : 0)
+	 * if (x >= modulus || x^3 + B is not a square)
+	 *   return false
+	 * y = sqrt(x^3 + B), chosen so that y % 2 == recid % 2
+	 * w = r^-1 % order
+	 * q = (-(msgHash * w) % order) * G + ((s * w) % order) * (x, y)
+	 * if (q == zero) return false
+	 * return q
+	 */
+	countOps(functionOps);
+	countOps(5 * arithmeticOps);
+	
+	const Uint256 &order = CurvePoint::ORDER;
+	const Uint256 &zero = Uint256::ZERO;
+	if (!(zero < r && r < order && zero < s && s < order) || recid > 3)
+		return false;
+	
+	// Reconstruct the nonce point from its x coordinate and the parity of its y coordinate
+	Uint256 x = r;
+	if ((recid & 2) != 0 && x.add(order) != 0)
+		return false;
+	uint8_t compressed[33];
+	compressed[0] = static_cast<uint8_t>(0x02 | (recid & 1));
+	x.getBigEndianBytes(&compressed[1]);
+	CurvePoint q = CurvePoint::ZERO;
+	if (!CurvePoint::fromCompressedPointVar(compressed, q))  // Also rejects x >= modulus
+		return false;
+	countOps(2 * arithmeticOps);
+	countOps(1 * uint256CopyOps);
+	countOps(1 * curvepointCopyOps);
+	
+	Scalar w(r);
+	w.reciprocalVar();
+	Scalar u1 = w;
+	Scalar u2 = w;
+	u1.multiply(Scalar(Uint256(msgHash.value)));
+	u1.negate();
+	u2.multiply(Scalar(s));
+	countOps(6 * uint256CopyOps);
+	
+	CurvePoint p = CurvePoint::multiplyGeneratorVar(PublicScalar(u1));
+	q.multiplyVar(PublicScalar(u2));
+	p.add(q);
+	if (p.isZero())
+		return false;
+	p.normalizeVar();
+	outPublicKey = p;
+	countOps(3 * curvepointCopyOps);
+	return true;
 }
 
 
 bool Ecdsa::verify(const CurvePoint &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s) {
 	/* 
 	 * Algorithm pseudocode:
-	 * if (pubKey == zero || !(pubKey is normalized) ||
-	 *     !(pubKey on curve) || n * pubKey != zero)
-	 *   return false
 	 * if (!(0 < r, s < order))
 	 *   return false
+	 * if (pubKey == zero || !(pubKey is normalized) || !(pubKey on curve))
+	 *   return false
+	 * return verify(PublicKey(pubKey), msgHash, r, s)
+	 */
+	countOps(functionOps);
+	countOps(5 * arithmeticOps);
+	
+	const Uint256 &order = CurvePoint::ORDER;
+	const Uint256 &zero = Uint256::ZERO;
+	if (!(zero < r && r < order && zero < s && s < order))
+		return false;
+	const PublicKey key(publicKey);
+	if (!key.isValid())
+		return false;
+	countOps(1 * arithmeticOps);
+	return verify(key, msgHash, r, s);
+}
+
+
+bool Ecdsa::verify(const PublicKey &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s) {
+	/* 
+	 * Algorithm pseudocode:
+	 * if (!(0 < r, s < order) || !(pubKey is valid))
+	 *   return false
 	 * w = s^-1 % order
 	 * u1 = (msgHash * w) % order
 	 * u2 = (r * w) % order
 	 * p = u1 * G + u2 * pubKey
 	 * return r == p.x % order
+	 * 
+	 * The term u1 * G uses the fixed-base table, and u2 * pubKey uses the GLV split with wNAF digits.
 	 */
 	countOps(functionOps);
-	countOps(11 * arithmeticOps);
+	countOps(6 * arithmeticOps);
 	
 	const Uint256 &order = CurvePoint::ORDER;
 	const Uint256 &zero = Uint256::ZERO;
-	CurvePoint q = publicKey;
-	q.multiply(CurvePoint::ORDER);
-	if (!(zero < r && r < order && zero < s && s < order))
+	if (!(zero < r && r < order && zero < s && s < order) || !publicKey.isValid())
 		return false;
-	countOps(5 * arithmeticOps);
-	if (publicKey.isZero() || publicKey.z != CurvePoint::FI_ONE || !publicKey.isOnCurve() || !q.isZero())
-		return false;
-	countOps(4 * arithmeticOps);
-	countOps(1 * curvepointCopyOps);
 	
-	Uint256 w = s;
-	w.reciprocal(order);
-	const Uint256 z(msgHash.value);
-	Uint256 u1 = w;
-	Uint256 u2 = w;
-	multiplyModOrder(u1, z);
-	multiplyModOrder(u2, r);
-	countOps(4 * uint256CopyOps);
-	
-	CurvePoint p = CurvePoint::G;
-	q = publicKey;
-	p.multiply(u1);
-	q.multiply(u2);
+	Scalar w(s);
+	w.reciprocalVar();
+	Scalar u1 = w;
+	Scalar u2 = w;
+	u1.multiply(Scalar(Uint256(msgHash.value)));
+	u2.multiply(Scalar(r));
+	countOps(6 * uint256CopyOps);
+	
+	CurvePoint p = CurvePoint::multiplyGeneratorVar(PublicScalar(u1));
+	CurvePoint q = publicKey.getPoint();
+	q.multiplyVar(PublicScalar(u2));
 	p.add(q);
-	p.normalize();
+	p.normalizeVar();
 	countOps(2 * curvepointCopyOps);
 	
 	Uint256 px(p.x);
@@ -135,35 +273,305 @@ bool Ecdsa::verify(const CurvePoint &publicKey, const Sha256Hash &msgHash, const
 }
 
 
-void Ecdsa::multiplyModOrder(Uint256 &x, const Uint256 &y) {
+bool Ecdsa::verify(const PreparedPublicKey &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s) {
 	/* 
-	 * Russian peasant multiplication with modular reduction at each step. Algorithm pseudocode:
-	 * z = 0
-	 * for (i = 255 .. 0) {
-	 *   z = (z * 2) % order
-	 *   if (y.bit[i] == 1)
-	 *     z = (z + x) % order
-	 * }
-	 * x = z
+	 * Algorithm pseudocode: same as verify(PublicKey), except
+	 * p = u1 * G + u2 * pubKey is computed with the precomputed tables of G and pubKey
 	 */
 	countOps(functionOps);
-	const Uint256 &mod = CurvePoint::ORDER;
-	assert(&x != &y && x < mod);
-	Uint256 z = Uint256::ZERO;
+	countOps(6 * arithmeticOps);
+	
+	const Uint256 &order = CurvePoint::ORDER;
+	const Uint256 &zero = Uint256::ZERO;
+	if (!(zero < r && r < order && zero < s && s < order) || !publicKey.isValid())
+		return false;
+	
+	Scalar w(s);
+	w.reciprocalVar();
+	Scalar u1 = w;
+	Scalar u2 = w;
+	u1.multiply(Scalar(Uint256(msgHash.value)));
+	u2.multiply(Scalar(r));
+	countOps(6 * uint256CopyOps);
+	
+	CurvePoint p = PreparedPublicKey::multiplyAddVar(PublicScalar(u1), PreparedPublicKey::getGenerator(), PublicScalar(u2), publicKey);
+	p.normalizeVar();
+	countOps(1 * curvepointCopyOps);
+	
+	Uint256 px(p.x);
+	px.subtract(order, static_cast<uint32_t>(px >= order));
 	countOps(1 * uint256CopyOps);
+	return r == px;
+}
+
+
+bool Ecdsa::verifyBatch(const BatchEntry entries[], std::size_t len, std::size_t &outFailIndex) {
+	/* 
+	 * Algorithm pseudocode:
+	 * if (any entry fails the range and curve checks of verify())
+	 *   return verifyEach()
+	 * w[i] = s[i]^-1 % order, for all i with only one inversion
+	 * for each entry:
+	 *   p = ((msgHash * w[i]) % order) * G + ((r * w[i]) % order) * pubKey
+	 *   if (p == zero || r != p.x % order)
+	 *     return verifyEach()
+	 * return true
+	 * 
+	 * The signature equations cannot be merged into one multi-scalar multiplication: r only fixes the x coordinate
+	 * of p, not its sign, so a weighted sum of the equations would need each p's y coordinate. They are checked
+	 * one by one, sharing the inversion. No subgroup check is needed, because the curve's cofactor is 1.
+	 */
+	countOps(functionOps);
+	const Uint256 &order = CurvePoint::ORDER;
+	const Uint256 &zero = Uint256::ZERO;
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		const BatchEntry &e = entries[i];
+		if (!(zero < e.r && e.r < order && zero < e.s && e.s < order))
+			return verifyEach(entries, len, outFailIndex);
+		if (!PublicKey(e.publicKey).isValid())
+			return verifyEach(entries, len, outFailIndex);
+		countOps(6 * arithmeticOps);
+	}
 	
-	for (int i = Uint256::NUM_WORDS * 32 - 1; i >= 0; i--) {
+	// Invert all the s values at once
+	std::vector<Scalar> inverses;
+	inverses.reserve(len);
+	for (std::size_t i = 0; i < len; i++) {
 		countOps(loopBodyOps);
-		// Multiply by 2
-		uint32_t c = z.shiftLeft1();
-		z.subtract(mod, c | static_cast<uint32_t>(z >= mod));
-		// Conditionally add x
-		uint32_t enable = (y.value[i >> 5] >> (i & 31)) & 1;
-		c = z.add(x, enable);
-		z.subtract(mod, c | static_cast<uint32_t>(z >= mod));
-		assert(z < mod);
-		countOps(7 * arithmeticOps);
+		inverses.push_back(Scalar(entries[i].s));
+		countOps(1 * uint256CopyOps);
 	}
-	x = z;
-	countOps(1 * uint256CopyOps);
+	std::vector<Scalar> scratch(len, Scalar(Uint256::ZERO));
+	Scalar::reciprocalBatchVar(inverses.data(), len, scratch.data());
+	
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		const BatchEntry &e = entries[i];
+		Scalar u1 = inverses[i];
+		Scalar u2 = inverses[i];
+		u1.multiply(Scalar(Uint256(e.msgHash.value)));
+		u2.multiply(Scalar(e.r));
+		CurvePoint p = CurvePoint::multiplyGeneratorVar(PublicScalar(u1));
+		CurvePoint q = e.publicKey;
+		q.multiplyVar(PublicScalar(u2));
+		p.add(q);
+		if (p.isZero())
+			return verifyEach(entries, len, outFailIndex);
+		countOps(6 * uint256CopyOps);
+		countOps(3 * curvepointCopyOps);
+		
+		// Compare without normalizing: p.x / p.z % order == r iff p.x == r * p.z, or r + order < modulus
+		// and p.x == (r + order) * p.z (because p.x / p.z < modulus < 2 * order)
+		FieldInt rz(e.r);
+		rz.multiply(p.z);
+		if (p.x != rz) {
+			Uint256 rn = e.r;
+			uint32_t carry = rn.add(order);
+			FieldInt rnz(rn);
+			if (carry != 0 || Uint256(rnz) != rn)  // r + order is not less than the modulus
+				return verifyEach(entries, len, outFailIndex);
+			rnz.multiply(p.z);
+			if (p.x != rnz)
+				return verifyEach(entries, len, outFailIndex);
+		}
+		countOps(6 * arithmeticOps);
+	}
+	return true;
+}
+
+
+bool Ecdsa::signatureFromDer(const uint8_t der[], std::size_t len, Uint256 &outR, Uint256 &outS) {
+	/* 
+	 * Format: 0x30 [total-length] 0x02 [R-length] [R] 0x02 [S-length] [S], where both lengths are checked
+	 * against the actual length of the buffer before anything is read (as in BIP 66's IsValidSignatureEncoding()).
+	 */
+	assert(der != nullptr || len == 0);
+	if (len < 8 || len > static_cast<std::size_t>(MAX_DER_LEN))
+		return false;
+	if (der[0] != 0x30 || der[1] != len - 2)
+		return false;
+	std::size_t lenR = der[3];
+	if (lenR + 5 >= len)
+		return false;
+	std::size_t lenS = der[lenR + 5];
+	if (lenR + lenS + 6 != len)
+		return false;
+	Uint256 r, s;
+	if (!integerFromDer(&der[2], lenR + 2, r) || !integerFromDer(&der[lenR + 4], lenS + 2, s))
+		return false;
+	outR = r;
+	outS = s;
+	return true;
+}
+
+
+std::size_t Ecdsa::signatureToDer(const Uint256 &r, const Uint256 &s, uint8_t out[MAX_DER_LEN]) {
+	assert(out != nullptr);
+	std::size_t lenR = integerToDer(r, &out[2]);
+	std::size_t lenS = integerToDer(s, &out[2 + lenR]);
+	out[0] = 0x30;
+	out[1] = static_cast<uint8_t>(lenR + lenS);
+	return lenR + lenS + 2;
+}
+
+
+void Ecdsa::signatureFromCompact(const uint8_t in[COMPACT_LEN], Uint256 &outR, Uint256 &outS) {
+	assert(in != nullptr);
+	outR = Uint256(&in[0]);
+	outS = Uint256(&in[32]);
+}
+
+
+void Ecdsa::signatureToCompact(const Uint256 &r, const Uint256 &s, uint8_t out[COMPACT_LEN]) {
+	assert(out != nullptr);
+	r.getBigEndianBytes(&out[0]);
+	s.getBigEndianBytes(&out[32]);
+}
+
+
+bool Ecdsa::signaturesFromDer(const uint8_t buffer[], std::size_t bufferLen,
+		BatchEntry entries[], std::size_t len, std::size_t &outFailIndex) {
+	assert(buffer != nullptr || bufferLen == 0);
+	std::size_t offset = 0;
+	for (std::size_t i = 0; i < len; i++) {
+		// Each signature's own length byte says where the next one starts
+		std::size_t sigLen = 0;
+		if (bufferLen - offset >= 2)
+			sigLen = buffer[offset + 1] + 2u;
+		if (sigLen == 0 || sigLen > bufferLen - offset
+				|| !signatureFromDer(&buffer[offset], sigLen, entries[i].r, entries[i].s)) {
+			outFailIndex = i;
+			return false;
+		}
+		offset += sigLen;
+	}
+	if (offset != bufferLen) {
+		outFailIndex = len;
+		return false;
+	}
+	return true;
+}
+
+
+bool Ecdsa::verifyEach(const BatchEntry entries[], std::size_t len, std::size_t &outFailIndex) {
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		const BatchEntry &e = entries[i];
+		if (!verify(e.publicKey, e.msgHash, e.r, e.s)) {
+			outFailIndex = i;
+			return false;
+		}
+	}
+	return true;
+}
+
+
+Uint256 Ecdsa::getHmacNonce(const Uint256 &privateKey, const Sha256Hash &msgHash) {
+	uint8_t privkeyBytes[Uint256::NUM_WORDS * 4];
+	privateKey.getBigEndianBytes(privkeyBytes);
+	const Sha256Hash hmac = Sha256::getHmac(privkeyBytes, sizeof(privkeyBytes), msgHash.value, Sha256Hash::HASH_LEN);
+	return Uint256(hmac.value);
+}
+
+
+void Ecdsa::signWithGenerator(const Uint256 &privateKey, const Sha256Hash &msgHash, Rfc6979 &gen, Uint256 &outR, Uint256 &outS) {
+	while (!sign(privateKey, msgHash, gen.next(), outR, outS));
+}
+
+
+void Ecdsa::signChunk(const Uint256 privateKeys[], const Sha256Hash msgHashes[], std::size_t len,
+		Uint256 outR[], Uint256 outS[], uint8_t outOk[]) {
+	/* 
+	 * Algorithm pseudocode: the same as sign() for each entry, except that
+	 * all nonce points k[i] * G are normalized with normalizeBatch(), and
+	 * all k[i]^-1 are computed with reciprocalBatch().
+	 * An out-of-range nonce (vanishing probability) is replaced by 1 so that
+	 * the batch stays well defined, and its entry is marked as failed. The
+	 * outputs of every failed entry are set to zero, because a signature made
+	 * with the nonce 1 would reveal the private key.
+	 */
+	countOps(functionOps);
+	const Uint256 &order = CurvePoint::ORDER;
+	const Uint256 &zero = Uint256::ZERO;
+	std::vector<CurvePoint> points;
+	std::vector<Scalar> kInvs;
+	points.reserve(len);
+	kInvs.reserve(len);
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		Uint256 nonce = getHmacNonce(privateKeys[i], msgHashes[i]);
+		uint32_t nonceOk = static_cast<uint32_t>(nonce != zero) & static_cast<uint32_t>(nonce < order);
+		nonce.replace(Uint256::ONE, nonceOk ^ 1);
+		outOk[i] = static_cast<uint8_t>(nonceOk);
+		points.push_back(CurvePoint::multiplyGenerator(nonce));
+		kInvs.push_back(Scalar(nonce));
+		countOps(2 * arithmeticOps);
+		countOps(2 * uint256CopyOps);
+		countOps(1 * curvepointCopyOps);
+	}
+	CurvePoint::normalizeBatch(points.data(), len);
+	std::vector<Scalar> scratch(len, Scalar(zero));
+	Scalar::reciprocalBatch(kInvs.data(), len, scratch.data());
+	
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		Uint256 r(points[i].x);
+		r.subtract(order, static_cast<uint32_t>(r >= order));
+		Scalar s(r);
+		s.multiply(Scalar(privateKeys[i]));
+		s.add(Scalar(Uint256(msgHashes[i].value)));
+		s.multiply(kInvs[i]);
+		uint32_t failed = static_cast<uint32_t>(outOk[i] ^ 1) | static_cast<uint32_t>(r == zero)
+			| static_cast<uint32_t>(s == Scalar(zero));
+		Scalar negS = s;
+		negS.negate();
+		s.replace(negS, static_cast<uint32_t>(negS < s));  // To ensure low S values for BIP 62
+		r.replace(zero, failed);
+		s.replace(Scalar(zero), failed);
+		outOk[i] = static_cast<uint8_t>(failed ^ 1);
+		outR[i] = r;
+		outS[i] = Uint256(s);
+		countOps(8 * arithmeticOps);
+		countOps(8 * uint256CopyOps);
+	}
+}
+
+
+bool Ecdsa::integerFromDer(const uint8_t in[], std::size_t len, Uint256 &out) {
+	std::size_t n = len - 2;  // Length of the content
+	const uint8_t *content = &in[2];
+	if (in[0] != 0x02 || in[1] != n || n == 0)
+		return false;
+	if ((content[0] & 0x80) != 0)  // Negative
+		return false;
+	if (n > 1 && content[0] == 0x00 && (content[1] & 0x80) == 0)  // Unnecessary leading zero
+		return false;
+	if (n > Uint256::NUM_WORDS * 4 + 1 || (n == Uint256::NUM_WORDS * 4 + 1 && content[0] != 0x00))  // Over 256 bits
+		return false;
+	
+	// Accumulate the bytes from the least significant end directly into the little-endian words
+	Uint256 result(Uint256::ZERO);
+	for (std::size_t i = 0; i < n && i < Uint256::NUM_WORDS * 4; i++)
+		result.value[i >> 2] |= static_cast<uint32_t>(content[n - 1 - i]) << ((i & 3) << 3);
+	out = result;
+	return true;
+}
+
+
+std::size_t Ecdsa::integerToDer(const Uint256 &val, uint8_t out[]) {
+	// Find the number of significant bytes, at least 1, reading them straight from the words
+	int n = Uint256::NUM_WORDS * 4;
+	while (n > 1 && static_cast<uint8_t>(val.value[(n - 1) >> 2] >> (((n - 1) & 3) << 3)) == 0)
+		n--;
+	bool pad = (val.value[(n - 1) >> 2] >> (((n - 1) & 3) << 3) & 0x80) != 0;  // Keep the integer nonnegative
+	std::size_t contentLen = static_cast<std::size_t>(n) + (pad ? 1 : 0);
+	out[0] = 0x02;
+	out[1] = static_cast<uint8_t>(contentLen);
+	uint8_t *p = &out[2];
+	if (pad)
+		*p++ = 0x00;
+	for (int i = n - 1; i >= 0; i--)
+		*p++ = static_cast<uint8_t>(val.value[i >> 2] >> ((i & 3) << 3));
+	return contentLen + 2;
 }
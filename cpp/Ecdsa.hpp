@@ -8,16 +8,25 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include "CurvePoint.hpp"
+#include "PreparedPublicKey.hpp"
+#include "PublicKey.hpp"
+#include "Rfc6979.hpp"
 #include "Sha256Hash.hpp"
 #include "Uint256.hpp"
 
 
 /* 
- * Performs ECDSA signature generation and verification. Provides just three static functions.
+ * Performs ECDSA signature generation and verification. Provides just a few static functions.
  */
 class Ecdsa final {
 	
+	public: static constexpr int MAX_DER_LEN = 72;  // Longest strict DER signature, when both r and s need 33 bytes
+	public: static constexpr int COMPACT_LEN = 64;
+	
+	
 	// Computes the signature (deterministically) when given the private key, message hash, and random nonce.
 	// Returns true if signing was successful (overwhelming probability), or false if a new nonce must be chosen
 	// (vanishing probability). Both privateKey and nonce must be in the range [1, CurvePoint::ORDER).
@@ -34,13 +43,134 @@ class Ecdsa final {
 	public: static bool signWithHmacNonce(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS);
 	
 	
+	// Computes a deterministic nonce as specified in RFC 6979 (see class Rfc6979), and then performs ECDSA signing.
+	// This gives the same signatures as other RFC 6979 signers, unlike signWithHmacNonce(). Returns true iff
+	// signing is successful, which happens iff privateKey is in the range [1, CurvePoint::ORDER); if a nonce fails
+	// (vanishing probability) then the next DRBG output is tried. This has the same constant-time behavior as sign().
+	public: static bool signWithRfc6979Nonce(const Uint256 &privateKey, const Sha256Hash &msgHash, Uint256 &outR, Uint256 &outS);
+	
+	
+	// Same as the other signWithRfc6979Nonce(), but with the given 32 bytes of extra entropy added to the nonce seed
+	// (RFC 6979 section 3.6, compatible with the ndata argument of libsecp256k1). This has the same constant-time behavior.
+	public: static bool signWithRfc6979Nonce(const Uint256 &privateKey, const Sha256Hash &msgHash,
+		const std::uint8_t extraEntropy[32], Uint256 &outR, Uint256 &outS);
+	
+	
+	// Computes len signatures with the same results as calling signWithHmacNonce(privateKeys[i], msgHashes[i], outR[i],
+	// outS[i]) for each i, splitting the work into contiguous chunks over numThreads threads (0 means one per hardware
+	// thread). Within a chunk, the nonce points are normalized with one field inversion and the nonces are inverted
+	// with one scalar inversion. Returns true if every signature succeeded. Otherwise returns false and sets
+	// outFailIndex to the lowest failed index (vanishing probability). The outputs of the successful entries are
+	// still assigned, and those of every failed entry are set to zero (where signWithHmacNonce() would assign
+	// nothing), so that no signature made with a substitute nonce is ever returned. Each signature is constant-time
+	// with respect to the input values, including whether it fails; the thread count and len are public.
+	public: static bool signBatch(const Uint256 privateKeys[], const Sha256Hash msgHashes[], std::size_t len,
+		Uint256 outR[], Uint256 outS[], unsigned int numThreads, std::size_t &outFailIndex);
+	
+	
+	// Computes the same signature as sign(), and also the recovery ID in the range [0, 4) that lets recover()
+	// find the public key from the signature alone. Bit 0 of the ID is the parity of the nonce point's y coordinate
+	// (after the low-S adjustment), and bit 1 is set iff its x coordinate was at least the order. outRecid is
+	// assigned iff signing is successful. This has the same constant-time behavior as sign().
+	public: static bool signRecoverable(const Uint256 &privateKey, const Sha256Hash &msgHash, const Uint256 &nonce,
+		Uint256 &outR, Uint256 &outS, std::uint8_t &outRecid);
+	
+	
+	// Computes the public key that makes the given signature and message hash valid, given the recovery ID
+	// from signRecoverable(). Returns true and sets outPublicKey to the (normalized) key if one exists,
+	// otherwise returns false. Not constant-time, because all inputs are public.
+	public: static bool recover(const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s, std::uint8_t recid, CurvePoint &outPublicKey);
+	
+	
 	// Checks whether the given signature, message, and public key are valid together. The public key point
 	// must be normalized. This function does not need to be constant-time because all inputs are public.
 	public: static bool verify(const CurvePoint &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s);
 	
 	
-	// Computes x = (x * y) % CurvePoint::ORDER. Requires x < CurvePoint::ORDER, but y is unrestricted.
-	private: static void multiplyModOrder(Uint256 &x, const Uint256 &y);
+	// Checks whether the given signature, message, and public key are valid together. Unlike the overload above,
+	// no work is spent on validating the key, which was done once when the PublicKey was constructed; an invalid
+	// key simply makes this return false. This function does not need to be constant-time because all inputs are public.
+	public: static bool verify(const PublicKey &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s);
+	
+	
+	// Checks whether the given signature, message, and public key are valid together, like the overload above,
+	// but using the key's precomputed table instead of building one on every call. An invalid key makes this
+	// return false. This function does not need to be constant-time because all inputs are public.
+	public: static bool verify(const PreparedPublicKey &publicKey, const Sha256Hash &msgHash, const Uint256 &r, const Uint256 &s);
+	
+	
+	// One (public key, message hash, signature) tuple to be checked by verifyBatch().
+	public: struct BatchEntry final {
+		public: CurvePoint publicKey;
+		public: Sha256Hash msgHash;
+		public: Uint256 r;
+		public: Uint256 s;
+	};
+	
+	
+	// Checks whether all of the len given entries are valid, i.e. whether verify() would return true for
+	// every one of them. Returns true if so (including when len is 0). Otherwise returns false and sets
+	// outFailIndex to the lowest index whose entry is invalid. Each entry is still verified separately; the
+	// only work shared between entries is that the modular inverses of all s values are computed with a
+	// single inversion. (ECDSA equations cannot be soundly combined, because r fixes only an x coordinate.)
+	// Not constant-time.
+	public: static bool verifyBatch(const BatchEntry entries[], std::size_t len, std::size_t &outFailIndex);
+	
+	
+	// Parses the given signature in strict DER format, as required by BIP 66 (without a trailing sighash byte), setting
+	// outR and outS iff the encoding is valid. The integers are read straight from the buffer into the words of outR and
+	// outS. Only the encoding is checked, not whether r and s are in range, which verify() does. Not constant-time.
+	public: static bool signatureFromDer(const std::uint8_t der[], std::size_t len, Uint256 &outR, Uint256 &outS);
+	
+	
+	// Writes the given signature in strict DER format and returns its length, which is at most MAX_DER_LEN.
+	// The integers are read straight from the words of r and s. Not constant-time.
+	public: static std::size_t signatureToDer(const Uint256 &r, const Uint256 &s, std::uint8_t out[MAX_DER_LEN]);
+	
+	
+	// Parses the given signature in compact format (r and s as 32-byte big-endian integers). Every input is
+	// accepted; whether r and s are in range is checked by verify(). Constant-time with respect to the values.
+	public: static void signatureFromCompact(const std::uint8_t in[COMPACT_LEN], Uint256 &outR, Uint256 &outS);
+	
+	
+	// Writes the given signature in compact format. Constant-time with respect to the values.
+	public: static void signatureToCompact(const Uint256 &r, const Uint256 &s, std::uint8_t out[COMPACT_LEN]);
+	
+	
+	// Parses len strict DER signatures stored back to back in the given buffer into the r and s fields of entries,
+	// ahead of verifyBatch(). Returns true if all of them are valid and they fill the buffer exactly. Otherwise returns
+	// false and sets outFailIndex to the index of the first invalid signature, or to len if there are bytes left over;
+	// entries before that index have been assigned. Not constant-time.
+	public: static bool signaturesFromDer(const std::uint8_t buffer[], std::size_t bufferLen,
+		BatchEntry entries[], std::size_t len, std::size_t &outFailIndex);
+	
+	
+	// Calls verify() on each entry in order. Returns false and sets outFailIndex at the first rejected entry,
+	// or returns true if there is none. Not constant-time.
+	private: static bool verifyEach(const BatchEntry entries[], std::size_t len, std::size_t &outFailIndex);
+	
+	
+	// Returns the nonce used by signWithHmacNonce(). Constant-time with respect to both values.
+	private: static Uint256 getHmacNonce(const Uint256 &privateKey, const Sha256Hash &msgHash);
+	
+	
+	// Signs with successive nonces from the given generator until one succeeds. Requires 0 < privateKey < CurvePoint::ORDER.
+	private: static void signWithGenerator(const Uint256 &privateKey, const Sha256Hash &msgHash, Rfc6979 &gen, Uint256 &outR, Uint256 &outS);
+	
+	
+	// Signs one chunk for signBatch() on the calling thread, setting outOk[i] to 1 if signature i succeeded or 0 if not
+	// (in which case outR[i] and outS[i] are set to zero). Constant-time with respect to all values.
+	private: static void signChunk(const Uint256 privateKeys[], const Sha256Hash msgHashes[], std::size_t len,
+		Uint256 outR[], Uint256 outS[], std::uint8_t outOk[]);
+	
+	
+	// Parses one DER integer (tag, length, and big-endian content) that must span exactly len bytes, be nonnegative,
+	// be minimally encoded, and fit in 256 bits. Sets out iff it is valid. Not constant-time.
+	private: static bool integerFromDer(const std::uint8_t in[], std::size_t len, Uint256 &out);
+	
+	
+	// Writes the given number as a minimal DER integer (tag, length, and content) and returns the number of bytes.
+	private: static std::size_t integerToDer(const Uint256 &val, std::uint8_t out[]);
 	
 	
 	Ecdsa() = delete;  // Not instantiable
@@ -11,13 +11,24 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <vector>
+#include "AffinePoint.hpp"
 #include "CountOps.hpp"
 #include "CurvePoint.hpp"
+#include "Ecdh.hpp"
 #include "Ecdsa.hpp"
 #include "FieldInt.hpp"
+#include "JacobianPoint.hpp"
+#include "MultiplySumScratch.hpp"
+#include "PreparedPublicKey.hpp"
+#include "PublicKey.hpp"
+#include "PublicScalar.hpp"
+#include "Scalar.hpp"
+#include "Schnorr.hpp"
 #include "Sha256.hpp"
 #include "Sha256Hash.hpp"
 #include "Uint256.hpp"
@@ -34,15 +45,21 @@ void countOps(long n) {
 static void printOps(const char *name);
 static void doUint256();
 static void doFieldInt();
+static void doScalar();
 static void doCurvePoint();
 static void doEcdsa();
+static void doSchnorr();
+static void doEcdh();
 
 
 int main() {
 	doUint256();
 	doFieldInt();
+	doScalar();
 	doCurvePoint();
 	doEcdsa();
+	doSchnorr();
+	doEcdh();
 	return EXIT_SUCCESS;
 }
 
@@ -109,6 +126,20 @@ static void doUint256() {
 		x.reciprocal(y);
 		printOps("uiReciprocal");
 	}
+	{
+		Uint256 x(CurvePoint::G.x);  // Variable-time, so measure a typical value
+		Uint256 y = CurvePoint::ORDER;
+		opsCount = 0;
+		x.reciprocalVar(y);
+		printOps("uiReciprocalVar");
+	}
+	{
+		Uint256 x(CurvePoint::G.x);
+		Uint256 y = CurvePoint::ORDER;
+		opsCount = 0;
+		x.jacobiVar(y);
+		printOps("uiJacobiVar");
+	}
 	std::cout << std::endl;
 }
 
@@ -174,6 +205,102 @@ static void doFieldInt() {
 		x.reciprocal();
 		printOps("fiReciprocal");
 	}
+	{
+		FieldInt x = CurvePoint::G.x;
+		opsCount = 0;
+		x.reciprocalVar();
+		printOps("fiReciprocalVar");
+	}
+	for (int i = 0; i < 2; i++) {
+		constexpr int batchLen = 8;
+		std::vector<FieldInt> vals;
+		std::vector<FieldInt> scratch(batchLen, FieldInt(Uint256::ZERO));
+		FieldInt x(Uint256(CurvePoint::G.x));
+		for (int j = 0; j < batchLen; j++) {
+			x.add(x);
+			vals.push_back(x);
+		}
+		opsCount = 0;
+		if (i == 0)
+			FieldInt::reciprocalBatch(vals.data(), vals.size(), scratch.data());
+		else
+			FieldInt::reciprocalBatchVar(vals.data(), vals.size(), scratch.data());
+		opsCount /= batchLen;
+		printOps(i == 0 ? "fiReciprocalBatch (per number, batch of 8)" : "fiReciprocalBatchVar (per number, batch of 8)");
+	}
+	{
+		FieldInt x = CurvePoint::G.x;
+		opsCount = 0;
+		x.jacobiVar();
+		printOps("fiJacobiVar");
+	}
+	{
+		FieldInt x = CurvePoint::G.x;
+		opsCount = 0;
+		x.sqrt();
+		printOps("fiSqrt");
+	}
+	std::cout << std::endl;
+}
+
+
+static void doScalar() {
+	{
+		Scalar x(Uint256::ONE);
+		Scalar y(Uint256::ONE);
+		opsCount = 0;
+		x.add(y);
+		printOps("scAdd");
+	}
+	{
+		Scalar x(Uint256::ONE);
+		opsCount = 0;
+		x.negate();
+		printOps("scNegate");
+	}
+	{
+		Scalar x(Uint256::ONE);
+		Scalar y(Uint256::ONE);
+		opsCount = 0;
+		x.multiply(y);
+		printOps("scMultiply");
+	}
+	{
+		Scalar x(Uint256::ONE);
+		opsCount = 0;
+		x.reciprocal();
+		printOps("scReciprocal");
+	}
+	{
+		Scalar x((Uint256(CurvePoint::G.x)));
+		Scalar r1(Uint256::ZERO), r2(Uint256::ZERO);
+		opsCount = 0;
+		Scalar::splitLambda(x, r1, r2);
+		printOps("scSplitLambda");
+	}
+	{
+		Scalar x((Uint256(CurvePoint::G.x)));
+		opsCount = 0;
+		x.reciprocalVar();
+		printOps("scReciprocalVar");
+	}
+	for (int i = 0; i < 2; i++) {
+		constexpr int batchLen = 8;
+		std::vector<Scalar> vals;
+		std::vector<Scalar> scratch(batchLen, Scalar(Uint256::ZERO));
+		Scalar x(Uint256(Uint256(CurvePoint::G.x)));
+		for (int j = 0; j < batchLen; j++) {
+			x.add(x);
+			vals.push_back(x);
+		}
+		opsCount = 0;
+		if (i == 0)
+			Scalar::reciprocalBatch(vals.data(), vals.size(), scratch.data());
+		else
+			Scalar::reciprocalBatchVar(vals.data(), vals.size(), scratch.data());
+		opsCount /= batchLen;
+		printOps(i == 0 ? "scReciprocalBatch (per number, batch of 8)" : "scReciprocalBatchVar (per number, batch of 8)");
+	}
 	std::cout << std::endl;
 }
 
@@ -219,12 +346,116 @@ static void doCurvePoint() {
 		x.multiply(y);
 		printOps("cpMultiply");
 	}
+	{
+		CurvePoint x = CurvePoint::G;
+		CurvePoint y = CurvePoint::G;
+		Uint256 u = Uint256::ONE;
+		Uint256 v = Uint256::ONE;
+		opsCount = 0;
+		CurvePoint::multiplyAdd(u, x, v, y);
+		printOps("cpMultiplyAdd");
+	}
+	{
+		Uint256 x = Uint256::ONE;
+		CurvePoint::multiplyGenerator(x);  // Build the table outside of the measurement
+		opsCount = 0;
+		CurvePoint::multiplyGenerator(x);
+		printOps("cpMultiplyGenerator");
+	}
+	{
+		CurvePoint x = CurvePoint::G;
+		PublicScalar y((Uint256(CurvePoint::G.x)));  // Variable-time, so measure a typical value
+		opsCount = 0;
+		x.multiplyVar(y);
+		printOps("cpMultiplyVar");
+	}
+	{
+		PublicScalar x((Uint256(CurvePoint::G.x)));
+		CurvePoint::multiplyGenerator(Uint256::ONE);  // Build the table outside of the measurement
+		opsCount = 0;
+		CurvePoint::multiplyGeneratorVar(x);
+		printOps("cpMultiplyGeneratorVar");
+	}
+	{
+		Uint256 u = CurvePoint::ORDER;
+		u.subtract(Uint256::ONE);
+		PublicScalar v[2] = {PublicScalar(u), PublicScalar(u)};
+		CurvePoint x[2] = {CurvePoint::G, CurvePoint::G};
+		opsCount = 0;
+		CurvePoint::multiplySumVar(v, x, 2);
+		printOps("cpMultiplySumVar");
+	}
+	for (std::size_t len : {16, 256, 4096}) {
+		std::vector<PublicScalar> v;
+		std::vector<CurvePoint> x;
+		CurvePoint p = CurvePoint::G;
+		for (std::size_t i = 0; i < len; i++) {
+			const std::uint8_t msg[2] = {static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(i >> 8)};
+			v.push_back(PublicScalar(Scalar(Uint256(Sha256::getHash(msg, sizeof(msg)).value))));  // Full-width scalars
+			p.add(CurvePoint::G);
+			x.push_back(p);
+		}
+		CurvePoint::normalizeBatchVar(x.data(), len);
+		MultiplySumScratch scratch(len, 1);  // The counter is not thread-safe
+		opsCount = 0;
+		CurvePoint::multiplySumVar(v.data(), x.data(), len, scratch);
+		opsCount /= static_cast<long long>(len);
+		printOps((std::string("cpMultiplySumVar (scratch, per term, ") + std::to_string(len) + " terms)").c_str());
+	}
 	{
 		CurvePoint x = CurvePoint::G;
 		opsCount = 0;
 		x.normalize();
 		printOps("cpNormalize");
 	}
+	{
+		CurvePoint x = CurvePoint::G;
+		x.twice();
+		opsCount = 0;
+		x.normalizeVar();
+		printOps("cpNormalizeVar");
+	}
+	for (int i = 0; i < 2; i++) {
+		constexpr int batchLen = 8;
+		std::vector<CurvePoint> points;
+		CurvePoint x = CurvePoint::G;
+		for (int j = 0; j < batchLen; j++) {
+			x.twice();
+			points.push_back(x);
+		}
+		opsCount = 0;
+		if (i == 0)
+			CurvePoint::normalizeBatch(points.data(), points.size());
+		else
+			CurvePoint::normalizeBatchVar(points.data(), points.size());
+		opsCount /= batchLen;
+		printOps(i == 0 ? "cpNormalizeBatch (per point, batch of 8)" : "cpNormalizeBatchVar (per point, batch of 8)");
+	}
+	{
+		std::uint8_t compressed[33];
+		CurvePoint::G.toCompressedPoint(compressed);
+		CurvePoint x = CurvePoint::ZERO;
+		opsCount = 0;
+		CurvePoint::fromCompressedPoint(compressed, x);
+		printOps("cpFromCompressedPoint");
+		opsCount = 0;
+		CurvePoint::fromCompressedPointVar(compressed, x);
+		printOps("cpFromCompressedPointVar");
+		compressed[32] ^= 4;  // G.x XOR 4 is not the x coordinate of a curve point
+		opsCount = 0;
+		CurvePoint::fromCompressedPointVar(compressed, x);
+		printOps("cpFromCompressedPointVar (not on curve)");
+	}
+	{
+		std::uint8_t uncompressed[65];
+		uncompressed[0] = 0x04;
+		CurvePoint::G.x.getBigEndianBytes(&uncompressed[1]);
+		CurvePoint::G.y.getBigEndianBytes(&uncompressed[33]);
+		CurvePoint x = CurvePoint::ZERO;
+		opsCount = 0;
+		CurvePoint::fromUncompressedPoint(uncompressed, x);
+		printOps("cpFromUncompressedPoint");
+	}
 	{
 		CurvePoint x = CurvePoint::G;
 		opsCount = 0;
@@ -232,6 +463,32 @@ static void doCurvePoint() {
 		printOps("cpIsOnCurve");
 	}
 	std::cout << std::endl;
+	
+	{
+		JacobianPoint x(CurvePoint::G);
+		opsCount = 0;
+		x.twice();
+		printOps("jpTwice");
+	}
+	{
+		JacobianPoint x(CurvePoint::G);
+		JacobianPoint y(CurvePoint::G);
+		x.twice();
+		y.twice();
+		y.twice();
+		opsCount = 0;
+		x.addVar(y);
+		printOps("jpAddVar");
+	}
+	{
+		JacobianPoint x(CurvePoint::G);
+		const AffinePoint y(CurvePoint::G.x, CurvePoint::G.y);
+		x.twice();
+		opsCount = 0;
+		x.addMixedVar(y);
+		printOps("jpAddMixedVar");
+	}
+	std::cout << std::endl;
 }
 
 
@@ -245,15 +502,118 @@ static void doEcdsa() {
 		Ecdsa::sign(privKey, msgHash, nonce, outR, outS);
 		printOps("edSign");
 	}
+	{
+		Uint256 privKey = Uint256::ONE;
+		Sha256Hash msgHash = Sha256::getHash(nullptr, 0);
+		Uint256 outR, outS;
+		opsCount = 0;
+		Ecdsa::signWithHmacNonce(privKey, msgHash, outR, outS);
+		printOps("edSignWithHmacNonce");
+	}
+	{
+		constexpr int batchLen = 8;
+		std::vector<Uint256> privKeys(batchLen, Uint256::ONE);
+		std::vector<Sha256Hash> msgHashes(batchLen, Sha256::getHash(nullptr, 0));
+		std::vector<Uint256> outR(batchLen), outS(batchLen);
+		std::size_t failIndex;
+		opsCount = 0;
+		Ecdsa::signBatch(privKeys.data(), msgHashes.data(), batchLen, outR.data(), outS.data(), 1, failIndex);  // The counter is not thread-safe
+		opsCount /= batchLen;
+		printOps("edSignBatch (per signature, batch of 8)");
+	}
 	{
 		CurvePoint pubKey = CurvePoint::G;
 		Sha256Hash msgHash = Sha256::getHash(nullptr, 0);
-		Uint256 r = Uint256::ONE;
-		Uint256 s = Uint256::ONE;
+		Uint256 r, s;  // A real signature, because verification is not constant-time
+		Ecdsa::signWithHmacNonce(Uint256::ONE, msgHash, r, s);
 		opsCount = 0;
 		Ecdsa::verify(pubKey, msgHash, r, s);
 		printOps("edVerify");
 	}
+	{
+		PublicKey pubKey(CurvePoint::G);
+		Sha256Hash msgHash = Sha256::getHash(nullptr, 0);
+		Uint256 r, s;  // A real signature, because verification is not constant-time
+		Ecdsa::signWithHmacNonce(Uint256::ONE, msgHash, r, s);
+		opsCount = 0;
+		Ecdsa::verify(pubKey, msgHash, r, s);
+		printOps("edVerify (PublicKey)");
+	}
+	{
+		PreparedPublicKey pubKey((PublicKey(CurvePoint::G)));
+		Sha256Hash msgHash = Sha256::getHash(nullptr, 0);
+		Uint256 r, s;  // A real signature, because verification is not constant-time
+		Ecdsa::signWithHmacNonce(Uint256::ONE, msgHash, r, s);
+		PreparedPublicKey::getGenerator();  // Build the table outside of the measurement
+		opsCount = 0;
+		Ecdsa::verify(pubKey, msgHash, r, s);
+		printOps("edVerify (PreparedPublicKey)");
+	}
+	{
+		constexpr int batchLen = 8;
+		std::vector<Ecdsa::BatchEntry> batch;
+		for (int i = 0; i < batchLen; i++) {
+			Uint256 privKey = Uint256::ONE;
+			for (int j = 0; j < i; j++)
+				privKey.add(privKey);
+			Sha256Hash msgHash = Sha256::getHash(nullptr, 0);
+			Uint256 r, s;
+			Ecdsa::signWithHmacNonce(privKey, msgHash, r, s);
+			batch.push_back(Ecdsa::BatchEntry{CurvePoint::privateExponentToPublicPoint(privKey), msgHash, r, s});
+		}
+		std::size_t failIndex;
+		opsCount = 0;
+		Ecdsa::verifyBatch(batch.data(), batch.size(), failIndex);
+		opsCount /= batchLen;
+		printOps("edVerifyBatch (per signature, batch of 8)");
+	}
+	{
+		Sha256Hash msgHash = Sha256::getHash(nullptr, 0);
+		Uint256 r, s;  // A real signature, because recovery is not constant-time
+		std::uint8_t recid;
+		Ecdsa::signRecoverable(Uint256::ONE, msgHash, Uint256::ONE, r, s, recid);
+		CurvePoint pubKey = CurvePoint::ZERO;
+		opsCount = 0;
+		Ecdsa::recover(msgHash, r, s, recid, pubKey);
+		printOps("edRecover");
+	}
+	std::cout << std::endl;
+}
+
+
+static void doSchnorr() {
+	const std::uint8_t msg[32] = {};
+	std::uint8_t publicKey[Schnorr::PUBLIC_KEY_LEN];
+	std::uint8_t sig[Schnorr::SIGNATURE_LEN];
+	Schnorr::getPublicKey(Uint256::ONE, publicKey);
+	{
+		opsCount = 0;
+		Schnorr::sign(Uint256::ONE, msg, sizeof(msg), msg, sig);
+		printOps("snSign");
+	}
+	{
+		opsCount = 0;
+		Schnorr::verify(publicKey, msg, sizeof(msg), sig);
+		printOps("snVerify");
+	}
+	std::cout << std::endl;
+}
+
+
+static void doEcdh() {
+	const PublicKey peer(CurvePoint::G);
+	{
+		std::uint8_t secret[Ecdh::SECRET_LEN];
+		opsCount = 0;
+		Ecdh::sharedSecret(Uint256::ONE, peer, secret);
+		printOps("dhSharedSecret");
+	}
+	{
+		Sha256Hash hash = Sha256::getHash(nullptr, 0);
+		opsCount = 0;
+		Ecdh::sharedSecretSha256(Uint256::ONE, peer, hash);
+		printOps("dhSharedSecretSha256");
+	}
 	std::cout << std::endl;
 }
 
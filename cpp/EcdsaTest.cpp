@@ -11,7 +11,11 @@
 #include "TestHelper.hpp"
 #include <cstdio>
 #include <cstdlib>
+#include "CurvePoint.hpp"
 #include "Ecdsa.hpp"
+#include "PreparedPublicKey.hpp"
+#include "PublicKey.hpp"
+#include "Sha256.hpp"
 #include "Sha256Hash.hpp"
 #include "Uint256.hpp"
 
@@ -714,6 +718,8 @@ static void testEcdsaSignAndVerify() {
 		if (Uint256::ZERO < privateKey && privateKey < CurvePoint::ORDER) {
 			CurvePoint publicKey = CurvePoint::privateExponentToPublicPoint(privateKey);
 			assert(Ecdsa::verify(publicKey, msgHash, r, s));
+			assert(Ecdsa::verify(PublicKey(publicKey), msgHash, r, s));
+			assert(Ecdsa::verify(PreparedPublicKey(PublicKey(publicKey)), msgHash, r, s));
 		}
 		
 		numTestCases++;
@@ -1803,14 +1809,331 @@ static void testEcdsaVerify() {
 		Uint256 r(tc.rValue);
 		Uint256 s(tc.sValue);
 		assert(Ecdsa::verify(publicKey, msgHash, r, s) == tc.answer);
+		assert(Ecdsa::verify(PublicKey(publicKey), msgHash, r, s) == tc.answer);
+		assert(Ecdsa::verify(PreparedPublicKey(PublicKey(publicKey)), msgHash, r, s) == tc.answer);
 		numTestCases++;
 	}
 }
 
 
+static void testEcdsaVerifyBatch() {
+	// Build a batch of valid signatures
+	const vector<const char *> privateKeys{
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"0000000000000000000000000000000000000000000000000000000000000123",
+		"8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+		"41FAFE9B8AED4955413045F361506CC58C335DA64450788676844E8267179624",
+		"0000000900000000000100000000000200000008000000000000000000004000",
+	};
+	vector<Ecdsa::BatchEntry> valid;
+	for (size_t i = 0; i < privateKeys.size(); i++) {
+		const Uint256 privateKey(privateKeys.at(i));
+		const std::uint8_t msg[1] = {static_cast<std::uint8_t>(i)};
+		const Sha256Hash msgHash = Sha256::getHash(msg, sizeof(msg));
+		Uint256 r, s;
+		assert(Ecdsa::signWithHmacNonce(privateKey, msgHash, r, s));
+		valid.push_back(Ecdsa::BatchEntry{CurvePoint::privateExponentToPublicPoint(privateKey), msgHash, r, s});
+	}
+	
+	size_t failIndex = 99;
+	assert(Ecdsa::verifyBatch(valid.data(), 0, failIndex));
+	assert(Ecdsa::verifyBatch(valid.data(), 1, failIndex));
+	assert(Ecdsa::verifyBatch(valid.data(), valid.size(), failIndex));
+	assert(failIndex == 99);
+	numTestCases += 3;
+	
+	// Corrupt one entry at a time in various ways, at every position
+	for (size_t i = 0; i < valid.size(); i++) {
+		for (int j = 0; j < 7; j++) {
+			vector<Ecdsa::BatchEntry> batch = valid;
+			Ecdsa::BatchEntry &e = batch.at(i);
+			const Ecdsa::BatchEntry &other = valid.at((i + 1) % valid.size());
+			switch (j) {
+				case 0:  e.msgHash = other.msgHash;  break;
+				case 1:  e.publicKey = other.publicKey;  break;
+				case 2:  e.r = other.r;  break;
+				case 3:  e.s = other.s;  break;
+				case 4:  e.r = Uint256::ZERO;  break;
+				case 5:  e.s = CurvePoint::ORDER;  break;
+				case 6:  e.publicKey.y.add(CurvePoint::FI_ONE);  break;  // Off the curve
+				default:  assert(false);
+			}
+			failIndex = 99;
+			assert(!Ecdsa::verifyBatch(batch.data(), batch.size(), failIndex));
+			assert(failIndex == i);
+			
+			// A second invalid entry later in the batch must not change the reported index
+			if (i + 1 < batch.size()) {
+				batch.back().s = Uint256::ZERO;
+				assert(!Ecdsa::verifyBatch(batch.data(), batch.size(), failIndex));
+				assert(failIndex == i);
+			}
+			numTestCases++;
+		}
+	}
+}
+
+
+static void testEcdsaSignRecoverableAndRecover() {
+	const vector<const char *> privateKeys{
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"0000000000000000000000000000000000000000000000000000000000000123",
+		"8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+		"41FAFE9B8AED4955413045F361506CC58C335DA64450788676844E8267179624",
+		"0000000900000000000100000000000200000008000000000000000000004000",
+	};
+	for (size_t i = 0; i < privateKeys.size(); i++) {
+		const Uint256 privateKey(privateKeys.at(i));
+		const CurvePoint publicKey = CurvePoint::privateExponentToPublicPoint(privateKey);
+		for (int j = 0; j < 4; j++) {
+			const std::uint8_t msg[2] = {static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(j)};
+			const Sha256Hash msgHash = Sha256::getHash(msg, sizeof(msg));
+			const std::uint8_t nonceMsg[3] = {static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(j), 0xFF};
+			const Uint256 nonce(Sha256::getHash(nonceMsg, sizeof(nonceMsg)).value);
+			
+			// Same signature as sign()
+			Uint256 r0, s0, r, s;
+			std::uint8_t recid = 99;
+			assert(Ecdsa::sign(privateKey, msgHash, nonce, r0, s0));
+			assert(Ecdsa::signRecoverable(privateKey, msgHash, nonce, r, s, recid));
+			assert(r == r0 && s == s0 && recid < 2);  // Bit 1 has probability about 2^-128
+			
+			// Only the right recovery ID gives the key, and only for the right message
+			for (std::uint8_t k = 0; k < 6; k++) {
+				CurvePoint recovered = CurvePoint::ZERO;
+				bool ok = Ecdsa::recover(msgHash, r, s, k, recovered);
+				if (k == recid)
+					assert(ok && recovered == publicKey);
+				else if (k >= 2)
+					assert(!ok);  // r + order exceeds the modulus, or the ID is out of range
+				else
+					assert(ok && recovered != publicKey && Ecdsa::verify(recovered, msgHash, r, s));
+			}
+			const Sha256Hash otherHash = Sha256::getHash(nonceMsg, sizeof(nonceMsg));
+			CurvePoint recovered = CurvePoint::ZERO;
+			assert(Ecdsa::recover(otherHash, r, s, recid, recovered) && recovered != publicKey);
+			numTestCases++;
+		}
+	}
+	
+	// Out-of-range signatures
+	const Sha256Hash msgHash = Sha256::getHash(nullptr, 0);
+	CurvePoint recovered = CurvePoint::ZERO;
+	assert(!Ecdsa::recover(msgHash, Uint256::ZERO, Uint256::ONE, 0, recovered));
+	assert(!Ecdsa::recover(msgHash, Uint256::ONE, Uint256::ZERO, 0, recovered));
+	assert(!Ecdsa::recover(msgHash, CurvePoint::ORDER, Uint256::ONE, 0, recovered));
+	assert(!Ecdsa::recover(msgHash, Uint256::ONE, CurvePoint::ORDER, 0, recovered));
+	assert(recovered == CurvePoint::ZERO);
+	numTestCases += 4;
+}
+
+
+static void testEcdsaSignWithRfc6979Nonce() {
+	struct SignCase {
+		const char *privateKey;
+		const char *message;  // ASCII, hashed with SHA-256
+		const char *extraEntropy;  // Empty for none
+		const char *expectedR;
+		const char *expectedS;
+	};
+	const vector<SignCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000001", "Satoshi Nakamoto", "", "934B1EA10A4B3C1757E2B0C017D0B6143CE3C9A7E6A4A49860D7A6AB210EE3D8", "2442CE9D2B916064108014783E923EC36B49743E2FFA1C4496F01A512AAFD9E5"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "All those moments will be lost in time, like tears in rain. Time to die...", "", "8600DBD41E348FE5C9465AB92D23E3DB8B98B873BEECD930736488696438CB6B", "547FE64427496DB33BF66019DACBF0039C04199ABB0122918601DB38A72CFC21"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "Satoshi Nakamoto", "", "FD567D121DB66E382991534ADA77A6BD3106F0A1098C231E47993447CD6AF2D0", "6B39CD0EB1BC8603E159EF5C20A5C8AD685A45B06CE9BEBED3F153D10D93BED5"},
+		{"F8B8AF8CE3C7CCA5E300D33939540C10D45CE001B8F252BFBC57BA0342904181", "Alan Turing", "", "7063AE83E7F62BBB171798131B4A0564B956930092B33B07B395615D9EC7E15C", "58DFCC1E00A35E1572F366FFE34BA0FC47DB1E7189759B9FB233C5B05AB388EA"},
+		{"E91671C46231F833A6406CCBEA0E3E392C76C167BAC1CB013F6F1013980455C2", "There is a computer disease that anybody who works with computers knows about. It's a very serious disease and it interferes completely with the work. The trouble with computers is that you 'play' with them!", "", "B552EDD27580141F3B2A5463048CB7CD3E047B97C9F98076C32DBDF85A68718B", "279FA72DD19BFAE05577E06C7C0C1900C371FCD5893F7E1D56A37D30174671F6"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "Satoshi Nakamoto", "0000000000000000000000000000000000000000000000000000000000000001", "3F882C5314DA77BAAE73E6F22F58B9A9C7BB8D6A04DA09742F30DC0A61ABCF4D", "280D5A6C657F20D426C53A8EB4DD56C33358527C5B3BF7AA0CE8169501EE7435"},
+		{"8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8", "", "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F", "DC08106658F9F0121DEB490C4F8A5C2D9FAB32E10E9218C8A97D8AF6D05FDCB5", "0812151AAB83FA8A9995D14C77E11AA7C6D826341835596BF4A19CAE91D44A67"},
+	};
+	for (const SignCase &tc : cases) {
+		const Uint256 privateKey(tc.privateKey);
+		const Bytes msg = asciiBytes(tc.message);
+		const Sha256Hash msgHash = Sha256::getHash(msg.data(), msg.size());
+		const Bytes extra = hexBytes(tc.extraEntropy);
+		Uint256 r, s;
+		if (extra.empty())
+			assert(Ecdsa::signWithRfc6979Nonce(privateKey, msgHash, r, s));
+		else
+			assert(Ecdsa::signWithRfc6979Nonce(privateKey, msgHash, extra.data(), r, s));
+		assert(r == Uint256(tc.expectedR) && s == Uint256(tc.expectedS));
+		assert(Ecdsa::verify(CurvePoint::privateExponentToPublicPoint(privateKey), msgHash, r, s));
+		numTestCases++;
+	}
+	
+	// Private keys outside the range [1, order)
+	const Sha256Hash msgHash = Sha256::getHash(nullptr, 0);
+	const std::uint8_t extra[32] = {};
+	for (const char *key : {"0000000000000000000000000000000000000000000000000000000000000000", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141"}) {
+		Uint256 r, s;
+		assert(!Ecdsa::signWithRfc6979Nonce(Uint256(key), msgHash, r, s));
+		assert(!Ecdsa::signWithRfc6979Nonce(Uint256(key), msgHash, extra, r, s));
+		numTestCases++;
+	}
+}
+
+
+static void testEcdsaSignBatch() {
+	const vector<const char *> keyStrs{
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"0000000000000000000000000000000000000000000000000000000000000123",
+		"8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+		"41FAFE9B8AED4955413045F361506CC58C335DA64450788676844E8267179624",
+		"0000000900000000000100000000000200000008000000000000000000004000",
+	};
+	vector<Uint256> privateKeys;
+	vector<Sha256Hash> msgHashes;
+	vector<Uint256> expectedR, expectedS;
+	for (size_t i = 0; i < 11; i++) {
+		privateKeys.push_back(Uint256(keyStrs.at(i % keyStrs.size())));
+		const std::uint8_t msg[1] = {static_cast<std::uint8_t>(i)};
+		msgHashes.push_back(Sha256::getHash(msg, sizeof(msg)));
+		Uint256 r, s;
+		assert(Ecdsa::signWithHmacNonce(privateKeys.back(), msgHashes.back(), r, s));
+		expectedR.push_back(r);
+		expectedS.push_back(s);
+	}
+	
+	// Every prefix length, with various thread counts (0 = hardware concurrency)
+	for (size_t len = 0; len <= privateKeys.size(); len++) {
+		for (unsigned int numThreads : {1u, 2u, 3u, 16u, 0u}) {
+			vector<Uint256> r(len, Uint256::ZERO);
+			vector<Uint256> s(len, Uint256::ZERO);
+			size_t failIndex = 99;
+			assert(Ecdsa::signBatch(privateKeys.data(), msgHashes.data(), len, r.data(), s.data(), numThreads, failIndex));
+			assert(failIndex == 99);
+			for (size_t i = 0; i < len; i++)
+				assert(r.at(i) == expectedR.at(i) && s.at(i) == expectedS.at(i));
+			numTestCases++;
+		}
+	}
+}
+
+
+static void testEcdsaSignatureDerAndCompact() {
+	struct DerCase {
+		const char *r;
+		const char *s;
+		const char *der;
+	};
+	const vector<DerCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000001", "0000000000000000000000000000000000000000000000000000000000000001", "3006020101020101"},
+		{"0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000000000000000000000000000000000000000007F", "300602010002017F"},
+		{"0000000000000000000000000000000000000000000000000000000000000080", "0000000000000000000000000000000000000000000000000000000000000100", "30080202008002020100"},
+		{"28B7F3A019749CCE6FC677AFA8FAE72EC10E811ED4B04E1963143CEF87654B75", "04719F34FE9A47F2C9A22045485F3654DC3AC4A910A7B0B4C7A318F41DB65C9B", "3044022028B7F3A019749CCE6FC677AFA8FAE72EC10E811ED4B04E1963143CEF87654B75022004719F34FE9A47F2C9A22045485F3654DC3AC4A910A7B0B4C7A318F41DB65C9B"},
+		{"B4508AF745210F6702C687682FD5E8C8D99CD1C6A7AD450AB4640458E14474BA", "00421ED1256C6056D50A481D76B77CF5AA74A692556682E584A4872E8D8BBBCE", "3044022100B4508AF745210F6702C687682FD5E8C8D99CD1C6A7AD450AB4640458E14474BA021F421ED1256C6056D50A481D76B77CF5AA74A692556682E584A4872E8D8BBBCE"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "3046022100FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF022100FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"},
+	};
+	for (const DerCase &tc : cases) {
+		const Uint256 r(tc.r);
+		const Uint256 s(tc.s);
+		std::uint8_t der[Ecdsa::MAX_DER_LEN];
+		size_t len = Ecdsa::signatureToDer(r, s, der);
+		assert(Bytes(der, der + len) == hexBytes(tc.der));
+		
+		Uint256 r1, s1;
+		assert(Ecdsa::signatureFromDer(der, len, r1, s1) && r1 == r && s1 == s);
+		
+		std::uint8_t compact[Ecdsa::COMPACT_LEN];
+		Ecdsa::signatureToCompact(r, s, compact);
+		Uint256 r2, s2;
+		Ecdsa::signatureFromCompact(compact, r2, s2);
+		assert(r2 == r && s2 == s);
+		numTestCases++;
+	}
+	
+	// Encodings that violate BIP 66
+	const vector<const char *> invalid{
+		"",
+		"30050201010201",        // Too short
+		"3106020101020101",      // Wrong sequence tag
+		"3007020101020101",      // Total length too long
+		"3005020101020101",      // Total length too short
+		"300602010102010100",    // Trailing byte
+		"3006030101020101",      // Wrong integer tag for R
+		"3006020101030101",      // Wrong integer tag for S
+		"300602000201010000",    // Zero-length R
+		"3006020101020000",      // Zero-length S
+		"3006020181020101",      // Negative R
+		"3006020101020181",      // Negative S
+		"300702020001020101",    // R padded with an unnecessary zero
+		"300702010102020001",    // S padded with an unnecessary zero
+		"3006020401020101",      // R length overruns the sequence
+		"3006020101020201",      // S length overruns the sequence
+		"30460221010000000000000000000000000000000000000000000000000000000000000000022100FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",  // R over 256 bits
+		"30490224000000000000000000000000000000000000000000000000000000000000000000000000022100FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",  // Too long
+	};
+	for (const char *tc : invalid) {
+		const Bytes der = hexBytes(tc);
+		Uint256 r(Uint256::ONE), s(Uint256::ONE);
+		assert(!Ecdsa::signatureFromDer(der.data(), der.size(), r, s));
+		assert(r == Uint256::ONE && s == Uint256::ONE);  // Not assigned
+		numTestCases++;
+	}
+}
+
+
+static void testEcdsaSignaturesFromDer() {
+	// Sign a few messages and pack the DER encodings back to back
+	vector<Ecdsa::BatchEntry> expected;
+	Bytes buffer;
+	vector<size_t> offsets;
+	for (int i = 0; i < 5; i++) {
+		const Uint256 privateKey((i % 2 == 0) ? "0000000000000000000000000000000000000000000000000000000000000123" : "8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8");
+		const std::uint8_t msg[1] = {static_cast<std::uint8_t>(i)};
+		const Sha256Hash msgHash = Sha256::getHash(msg, sizeof(msg));
+		Uint256 r, s;
+		assert(Ecdsa::signWithHmacNonce(privateKey, msgHash, r, s));
+		expected.push_back(Ecdsa::BatchEntry{CurvePoint::privateExponentToPublicPoint(privateKey), msgHash, r, s});
+		std::uint8_t der[Ecdsa::MAX_DER_LEN];
+		size_t len = Ecdsa::signatureToDer(r, s, der);
+		offsets.push_back(buffer.size());
+		buffer.insert(buffer.end(), der, der + len);
+	}
+	
+	vector<Ecdsa::BatchEntry> entries = expected;
+	for (Ecdsa::BatchEntry &e : entries)
+		e.r = e.s = Uint256::ZERO;
+	size_t failIndex = 99;
+	assert(Ecdsa::signaturesFromDer(buffer.data(), buffer.size(), entries.data(), entries.size(), failIndex));
+	assert(failIndex == 99);
+	for (size_t i = 0; i < entries.size(); i++)
+		assert(entries.at(i).r == expected.at(i).r && entries.at(i).s == expected.at(i).s);
+	assert(Ecdsa::verifyBatch(entries.data(), entries.size(), failIndex));
+	assert(Ecdsa::signaturesFromDer(nullptr, 0, entries.data(), 0, failIndex));
+	numTestCases += 2;
+	
+	// A corrupted signature, left-over bytes, and a truncated buffer
+	for (size_t i = 0; i < offsets.size(); i++) {
+		Bytes bad = buffer;
+		bad.at(offsets.at(i) + 2) = 0x03;  // Integer tag of r
+		assert(!Ecdsa::signaturesFromDer(bad.data(), bad.size(), entries.data(), entries.size(), failIndex));
+		assert(failIndex == i);
+		numTestCases++;
+	}
+	Bytes extra = buffer;
+	extra.push_back(0x30);
+	assert(!Ecdsa::signaturesFromDer(extra.data(), extra.size(), entries.data(), entries.size(), failIndex));
+	assert(failIndex == entries.size());
+	assert(!Ecdsa::signaturesFromDer(buffer.data(), buffer.size() - 1, entries.data(), entries.size(), failIndex));
+	assert(failIndex == entries.size() - 1);
+	assert(!Ecdsa::signaturesFromDer(buffer.data(), offsets.back() + 1, entries.data(), entries.size(), failIndex));
+	assert(failIndex == entries.size() - 1);
+	numTestCases += 3;
+}
+
+
 int main() {
 	testEcdsaSignAndVerify();
 	testEcdsaVerify();
+	testEcdsaVerifyBatch();
+	testEcdsaSignRecoverableAndRecover();
+	testEcdsaSignWithRfc6979Nonce();
+	testEcdsaSignBatch();
+	testEcdsaSignatureDerAndCompact();
+	testEcdsaSignaturesFromDer();
 	std::printf("All %d test cases passed\n", numTestCases);
 	return EXIT_SUCCESS;
 }
@@ -9,6 +9,7 @@
 #include <cstring>
 #include "ExtendedPrivateKey.hpp"
 #include "Ripemd160.hpp"
+#include "Scalar.hpp"
 #include "Sha256.hpp"
 #include "Sha256Hash.hpp"
 #include "Sha512.hpp"
@@ -50,11 +51,12 @@ ExtendedPrivateKey ExtendedPrivateKey::getChildKey(uint32_t index) const {
 	uint8_t hash[Sha512::HASH_LEN];
 	Sha512::getHmac(chainCode, sizeof(chainCode) / sizeof(chainCode[0]), msg, sizeof(msg) / sizeof(msg[0]), hash);
 	
-	Uint256 num(hash);
-	if (num >= CurvePoint::ORDER)
+	const Uint256 tweak(hash);
+	if (tweak >= CurvePoint::ORDER)
 		return ExtendedPrivateKey();
-	uint32_t carry = num.add(privateKey);
-	num.subtract(CurvePoint::ORDER, carry | static_cast<uint32_t>(num >= CurvePoint::ORDER));
+	Scalar sum(tweak);
+	sum.add(Scalar(privateKey));
+	const Uint256 num(sum);
 	if (num == Uint256::ZERO)
 		return ExtendedPrivateKey();
 	
@@ -59,25 +59,174 @@ void FieldInt::multiply2() {
 }
 
 
+#if defined(FIELDINT_5X52)
+
 void FieldInt::square() {
 	countOps(functionOps);
-	multiply(*this);
+	uint64_t a[5];
+	toLimbs52(a);
+	
+	// Each cross product appears twice, so double one factor instead of adding it twice
+	unsigned __int128 columns[9] = {};
+	for (int i = 0; i < 5; i++) {
+		countOps(loopBodyOps);
+		columns[i * 2] += static_cast<unsigned __int128>(a[i]) * a[i];
+		uint64_t twice = a[i] << 1;
+		for (int j = i + 1; j < 5; j++) {
+			countOps(loopBodyOps);
+			columns[i + j] += static_cast<unsigned __int128>(twice) * a[j];
+			countOps(4 * arithmeticOps);
+		}
+		countOps(5 * arithmeticOps);
+	}
+	reduceColumns52(columns);
 }
 
 
 void FieldInt::multiply(const FieldInt &other) {
 	countOps(functionOps);
+	uint64_t a[5], b[5];
+	toLimbs52(a);
+	other.toLimbs52(b);
 	
-	// Compute raw product of (uint256 this->value) * (uint256 other.value) = (uint512 product0), via long multiplication
+	// Schoolbook product without carrying; every column stays below 5 * 2^104
+	unsigned __int128 columns[9] = {};
+	for (int i = 0; i < 5; i++) {
+		countOps(loopBodyOps);
+		for (int j = 0; j < 5; j++) {
+			countOps(loopBodyOps);
+			columns[i + j] += static_cast<unsigned __int128>(a[i]) * b[j];
+			countOps(4 * arithmeticOps);
+		}
+	}
+	reduceColumns52(columns);
+}
+
+
+void FieldInt::toLimbs52(uint64_t limbs[5]) const {
+	countOps(functionOps);
+	uint64_t w[4];
+	for (int i = 0; i < 4; i++) {
+		countOps(loopBodyOps);
+		w[i] = static_cast<uint64_t>(value[i * 2]) | static_cast<uint64_t>(value[i * 2 + 1]) << 32;
+		countOps(5 * arithmeticOps);
+	}
+	const uint64_t mask = (static_cast<uint64_t>(1) << 52) - 1;
+	limbs[0] = w[0] & mask;
+	limbs[1] = (w[0] >> 52 | w[1] << 12) & mask;
+	limbs[2] = (w[1] >> 40 | w[2] << 24) & mask;
+	limbs[3] = (w[2] >> 28 | w[3] << 36) & mask;
+	limbs[4] = w[3] >> 16;
+	countOps(20 * arithmeticOps);
+}
+
+
+void FieldInt::reduceColumns52(const unsigned __int128 columns[9]) {
+	/* 
+	 * Because MODULUS = 2^256 - 0x1000003D1, we have 2^256 = 0x1000003D1 and 2^260 = 0x1000003D10 (mod MODULUS).
+	 * Algorithm pseudocode:
+	 * t = columns with carries propagated (10 limbs of 52 bits)
+	 * t = t[0 : 5] + t[5 : 10] * 0x1000003D10, carried (5 limbs and a carry worth 2^260)
+	 * t = t mod 2^256 + (t >> 256) * 0x1000003D1, carried (twice, until t < 2^256)
+	 * if (t >= MODULUS)
+	 *   t -= MODULUS  (computed as t + 0x1000003D1 - 2^256)
+	 */
+	countOps(functionOps);
+	const uint64_t mask52 = (static_cast<uint64_t>(1) << 52) - 1;
+	const uint64_t mask48 = (static_cast<uint64_t>(1) << 48) - 1;
+	const uint64_t fold256 = UINT64_C(0x1000003D1);
+	const uint64_t fold260 = fold256 << 4;
+	
+	// Propagate the lazy carries of the 9 columns into 10 limbs of 52 bits
+	uint64_t t[10];
+	unsigned __int128 acc = 0;
+	for (int i = 0; i < 9; i++) {
+		countOps(loopBodyOps);
+		acc += columns[i];
+		t[i] = static_cast<uint64_t>(acc) & mask52;
+		acc >>= 52;
+		countOps(6 * arithmeticOps);
+	}
+	t[9] = static_cast<uint64_t>(acc);
+	
+	// Fold the high 5 limbs into the low 5 limbs
+	acc = 0;
+	for (int i = 0; i < 5; i++) {
+		countOps(loopBodyOps);
+		acc += t[i] + static_cast<unsigned __int128>(t[i + 5]) * fold260;
+		t[i] = static_cast<uint64_t>(acc) & mask52;
+		acc >>= 52;
+		countOps(8 * arithmeticOps);
+	}
+	
+	// Fold the bits at 2^256 and above, twice. After the second time, the value is less than 2^256.
+	uint64_t top = static_cast<uint64_t>(acc) << 4 | t[4] >> 48;
+	for (int k = 0; k < 2; k++) {
+		countOps(loopBodyOps);
+		t[4] &= mask48;
+		acc = static_cast<unsigned __int128>(top) * fold256;
+		for (int i = 0; i < 5; i++) {
+			countOps(loopBodyOps);
+			acc += t[i];
+			t[i] = static_cast<uint64_t>(acc) & mask52;
+			acc >>= 52;
+			countOps(6 * arithmeticOps);
+		}
+		assert(acc == 0);
+		top = t[4] >> 48;
+		countOps(6 * arithmeticOps);
+	}
+	assert(top == 0);
+	
+	// Conditionally subtract the modulus: t >= MODULUS iff t + 0x1000003D1 >= 2^256
+	uint64_t u[5];
+	uint64_t carry = fold256;
+	for (int i = 0; i < 5; i++) {
+		countOps(loopBodyOps);
+		uint64_t sum = t[i] + carry;
+		u[i] = sum & mask52;
+		carry = sum >> 52;
+		countOps(5 * arithmeticOps);
+	}
+	uint64_t select = -(u[4] >> 48);  // All ones iff t >= MODULUS
+	u[4] &= mask48;
+	for (int i = 0; i < 5; i++) {
+		countOps(loopBodyOps);
+		t[i] ^= (t[i] ^ u[i]) & select;
+		countOps(4 * arithmeticOps);
+	}
+	
+	// Pack the limbs back into 8 words of 32 bits
+	uint64_t w[4];
+	w[0] = t[0] | t[1] << 52;
+	w[1] = t[1] >> 12 | t[2] << 40;
+	w[2] = t[2] >> 24 | t[3] << 28;
+	w[3] = t[3] >> 36 | t[4] << 16;
+	for (int i = 0; i < 4; i++) {
+		countOps(loopBodyOps);
+		value[i * 2] = static_cast<uint32_t>(w[i]);
+		value[i * 2 + 1] = static_cast<uint32_t>(w[i] >> 32);
+		countOps(6 * arithmeticOps);
+	}
+	countOps(20 * arithmeticOps);
+	assert(*this < MODULUS);
+}
+
+#else
+
+void FieldInt::square() {
+	countOps(functionOps);
+	
+	// Compute the products value[i] * value[j] for i < j, each of which appears twice in the square
 	uint32_t product0[NUM_WORDS * 2] = {};
 	countOps(NUM_WORDS * 2 * arithmeticOps);
 	for (int i = 0; i < NUM_WORDS; i++) {
 		countOps(loopBodyOps);
 		uint32_t carry = 0;
 		countOps(1 * arithmeticOps);
-		for (int j = 0; j < NUM_WORDS; j++) {
+		for (int j = i + 1; j < NUM_WORDS; j++) {
 			countOps(loopBodyOps);
-			uint64_t sum = static_cast<uint64_t>(this->value[i]) * other.value[j];
+			uint64_t sum = static_cast<uint64_t>(value[i]) * value[j];
 			sum += static_cast<uint64_t>(product0[i + j]) + carry;  // Does not overflow
 			product0[i + j] = static_cast<uint32_t>(sum);
 			carry = static_cast<uint32_t>(sum >> 32);
@@ -87,97 +236,120 @@ void FieldInt::multiply(const FieldInt &other) {
 		countOps(1 * arithmeticOps);
 	}
 	
-	// Barrett reduction algorithm begins here (see https://www.nayuki.io/page/barrett-reduction-algorithm).
-	// Multiply by floor(2^512 / MODULUS), which is 2^256 + 2^32 + 0x3D1. Guaranteed to fit in a uint768.
-	uint32_t product1[NUM_WORDS * 3];
-	{
+	// Double the cross products and add the squares value[i]^2 on the diagonal, in one pass
+	uint32_t shiftIn = 0;
+	uint64_t carry = 0;
+	countOps(2 * arithmeticOps);
+	for (int i = 0; i < NUM_WORDS * 2; i += 2) {
+		countOps(loopBodyOps);
+		uint64_t square = static_cast<uint64_t>(value[i >> 1]) * value[i >> 1];
+		uint64_t sum = static_cast<uint64_t>(product0[i] << 1 | shiftIn) + static_cast<uint32_t>(square) + carry;
+		shiftIn = product0[i] >> 31;
+		product0[i] = static_cast<uint32_t>(sum);
+		sum = static_cast<uint64_t>(product0[i + 1] << 1 | shiftIn) + (square >> 32) + (sum >> 32);
+		shiftIn = product0[i + 1] >> 31;
+		product0[i + 1] = static_cast<uint32_t>(sum);
+		carry = sum >> 32;
+		countOps(27 * arithmeticOps);
+	}
+	assert(carry == 0 && shiftIn == 0);
+	reduce512(product0);
+}
+
+
+void FieldInt::multiply(const FieldInt &other) {
+	countOps(functionOps);
+	
+	// Compute raw product of (uint256 this->value) * (uint256 other.value) = (uint512 product0), via long multiplication
+	uint32_t product0[NUM_WORDS * 2] = {};
+	countOps(NUM_WORDS * 2 * arithmeticOps);
+	for (int i = 0; i < NUM_WORDS; i++) {
+		countOps(loopBodyOps);
 		uint32_t carry = 0;
 		countOps(1 * arithmeticOps);
-		for (int i = 0; i < NUM_WORDS * 3; i++) {
+		for (int j = 0; j < NUM_WORDS; j++) {
 			countOps(loopBodyOps);
-			uint64_t sum = carry;
-			countOps(2 * arithmeticOps);
-			if (i < NUM_WORDS * 2) {
-				sum += static_cast<uint64_t>(product0[i]) * 0x3D1;
-				countOps(4 * arithmeticOps);
-			}
-			countOps(4 * arithmeticOps);
-			if (1 <= i && i < NUM_WORDS * 2 + 1) {
-				sum += product0[i - 1];
-				countOps(3 * arithmeticOps);
-			}
-			countOps(2 * arithmeticOps);
-			if (i >= NUM_WORDS) {
-				sum += product0[i - NUM_WORDS];
-				countOps(3 * arithmeticOps);
-			}
-			product1[i] = static_cast<uint32_t>(sum);
+			uint64_t sum = static_cast<uint64_t>(this->value[i]) * other.value[j];
+			sum += static_cast<uint64_t>(product0[i + j]) + carry;  // Does not overflow
+			product0[i + j] = static_cast<uint32_t>(sum);
 			carry = static_cast<uint32_t>(sum >> 32);
-			assert(carry <= 0x3D3);
-			countOps(2 * arithmeticOps);
+			countOps(11 * arithmeticOps);
 		}
-		assert(carry == 0);
+		product0[i + NUM_WORDS] = carry;
+		countOps(1 * arithmeticOps);
 	}
+	reduce512(product0);
+}
+
+
+void FieldInt::reduce512(const uint32_t product0[NUM_WORDS * 2]) {
+	countOps(functionOps);
 	
-	// Virtually shift right by 512 bits, then multiply by MODULUS.
-	// Note that MODULUS = 2^256 - 2^32 - 0x3D1. Result fits in a uint512.
-	uint32_t *product1Shifted = &product1[NUM_WORDS * 2];  // Length NUM_WORDS
-	uint32_t product2[NUM_WORDS * 2];
-	countOps(1 * arithmeticOps);
+	// Special-form reduction: because MODULUS = 2^256 - 2^32 - 0x3D1, we have 2^256 = 2^32 + 0x3D1 (mod MODULUS).
+	// Fold the high half into the low half: folded = product0[0 : 8] + product0[8 : 16] * (2^32 + 0x3D1) < 2^290.
+	uint32_t folded[NUM_WORDS + 2];
 	{
-		uint32_t borrow = 0;
+		uint64_t carry = 0;
 		countOps(1 * arithmeticOps);
-		for (int i = 0; i < NUM_WORDS * 2; i++) {
+		for (int i = 0; i < NUM_WORDS + 2; i++) {
 			countOps(loopBodyOps);
-			uint64_t diff = -static_cast<uint64_t>(borrow);
-			countOps(1 * arithmeticOps);
+			uint64_t sum = carry;
 			countOps(2 * arithmeticOps);
 			if (i < NUM_WORDS) {
-				diff -= static_cast<uint64_t>(product1Shifted[i]) * 0x3D1;
-				countOps(4 * arithmeticOps);
+				sum += product0[i];
+				sum += static_cast<uint64_t>(product0[i + NUM_WORDS]) * 0x3D1;
+				countOps(7 * arithmeticOps);
 			}
 			countOps(4 * arithmeticOps);
 			if (1 <= i && i < NUM_WORDS + 1) {
-				diff -= product1Shifted[i - 1];
-				countOps(3 * arithmeticOps);
+				sum += product0[i - 1 + NUM_WORDS];
+				countOps(4 * arithmeticOps);
 			}
+			folded[i] = static_cast<uint32_t>(sum);
+			carry = sum >> 32;
 			countOps(2 * arithmeticOps);
-			if (i >= NUM_WORDS) {
-				diff += product1Shifted[i - NUM_WORDS];
-				countOps(3 * arithmeticOps);
-			}
-			product2[i] = static_cast<uint32_t>(diff);
-			borrow = -static_cast<uint32_t>(diff >> 32);
-			assert(borrow <= 0x3D3);
-			countOps(3 * arithmeticOps);
 		}
-		assert(borrow == 0);
+		assert(carry == 0);
 	}
 	
-	// Compute product0 - product2, which fits in a uint257 (sic)
-	uint32_t difference[NUM_WORDS + 1];
-	{
-		uint32_t borrow = 0;
-		countOps(1 * arithmeticOps);
-		for (int i = 0; i < NUM_WORDS + 1; i++) {
+	// Fold the bits at 2^256 and above twice more in the same way. The first of these leaves a value below
+	// 2^256 + 2^67, so the second one adds at most 2^32 + 0x3D1 to a value below 2^67, without overflowing.
+	uint64_t top = folded[NUM_WORDS] | static_cast<uint64_t>(folded[NUM_WORDS + 1]) << 32;
+	countOps(3 * arithmeticOps);
+	for (int k = 0; k < 2; k++) {
+		countOps(loopBodyOps);
+		uint64_t topLow = top & UINT32_C(0xFFFFFFFF);
+		uint64_t topHigh = top >> 32;
+		uint64_t carry = 0;
+		countOps(3 * arithmeticOps);
+		for (int i = 0; i < NUM_WORDS; i++) {  // Branches depend only on the public loop index
 			countOps(loopBodyOps);
-			uint64_t diff = static_cast<uint64_t>(product0[i]) - product2[i] - borrow;
-			difference[i] = static_cast<uint32_t>(diff);
-			borrow = -static_cast<uint32_t>(diff >> 32);
-			assert((borrow >> 1) == 0);
-			countOps(9 * arithmeticOps);
+			uint64_t sum = static_cast<uint64_t>(folded[i]) + carry;
+			countOps(2 * arithmeticOps);
+			if (i == 0)
+				sum += topLow * 0x3D1;
+			else if (i == 1)
+				sum += topHigh * 0x3D1 + topLow;
+			else if (i == 2)
+				sum += topHigh;
+			folded[i] = static_cast<uint32_t>(sum);
+			carry = sum >> 32;
+			countOps(6 * arithmeticOps);
 		}
+		top = carry;
 	}
+	assert(top == 0);
 	
 	// Final conditional subtraction to yield a FieldInt value
-	std::memcpy(this->value, difference, sizeof(value));
+	std::memcpy(this->value, folded, sizeof(value));
 	countOps(functionOps);
 	countOps(NUM_WORDS * arithmeticOps);
-	uint32_t dosub = static_cast<uint32_t>((difference[NUM_WORDS] != 0) | (*this >= MODULUS));
-	Uint256::subtract(MODULUS, dosub);
-	countOps(2 * arithmeticOps);
+	Uint256::subtract(MODULUS, static_cast<uint32_t>(*this >= MODULUS));
+	countOps(1 * arithmeticOps);
 }
 
+#endif
+
 
 void FieldInt::reciprocal() {
 	countOps(functionOps);
@@ -185,6 +357,133 @@ void FieldInt::reciprocal() {
 }
 
 
+void FieldInt::reciprocalVar() {
+	countOps(functionOps);
+	Uint256::reciprocalVar(MODULUS);
+}
+
+
+void FieldInt::reciprocalBatch(FieldInt vals[], std::size_t len, FieldInt scratch[]) {
+	/* 
+	 * Montgomery's trick: with scratch[i] = v[0] * ... * v[i] (using 1 in place of zero values), invert only
+	 * scratch[len-1], then walk backward: 1/v[i] = 1/scratch[i] * scratch[i-1], and 1/scratch[i-1] = 1/scratch[i] * v[i].
+	 */
+	countOps(functionOps);
+	if (len == 0)
+		return;
+	const FieldInt zero(Uint256::ZERO);
+	const FieldInt one(Uint256::ONE);
+	FieldInt acc = one;
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		FieldInt v = vals[i];
+		v.replace(one, static_cast<uint32_t>(v == zero));
+		acc.multiply(v);
+		scratch[i] = acc;
+		countOps(2 * fieldintCopyOps);
+	}
+	acc.reciprocal();
+	for (std::size_t i = len; i-- > 0; ) {
+		countOps(loopBodyOps);
+		FieldInt v = vals[i];
+		uint32_t isZero = static_cast<uint32_t>(v == zero);
+		v.replace(one, isZero);
+		FieldInt inv = acc;
+		if (i > 0)  // Depends only on the public loop index
+			inv.multiply(scratch[i - 1]);
+		acc.multiply(v);
+		inv.replace(zero, isZero);
+		vals[i] = inv;
+		countOps(3 * fieldintCopyOps);
+	}
+}
+
+
+void FieldInt::reciprocalBatchVar(FieldInt vals[], std::size_t len, FieldInt scratch[]) {
+	// Same algorithm as reciprocalBatch(), but zero values are skipped by branching
+	countOps(functionOps);
+	const FieldInt zero(Uint256::ZERO);
+	FieldInt acc(Uint256::ONE);
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		if (vals[i] != zero)
+			acc.multiply(vals[i]);
+		scratch[i] = acc;
+		countOps(1 * fieldintCopyOps);
+	}
+	acc.reciprocalVar();
+	for (std::size_t i = len; i-- > 0; ) {
+		countOps(loopBodyOps);
+		if (vals[i] == zero)
+			continue;
+		FieldInt inv = acc;
+		if (i > 0)
+			inv.multiply(scratch[i - 1]);
+		acc.multiply(vals[i]);
+		vals[i] = inv;
+		countOps(2 * fieldintCopyOps);
+	}
+}
+
+
+int FieldInt::jacobiVar() const {
+	countOps(functionOps);
+	return Uint256::jacobiVar(MODULUS);
+}
+
+
+bool FieldInt::sqrt() {
+	/* 
+	 * The prime is 3 mod 4, so if x is a square then x^((p+1)/4) is a square root of x. In binary, the exponent
+	 * is 223 ones, 1 zero, 22 ones, 4 zeros, 2 ones, 2 zeros. The addition chain (from libsecp256k1) builds
+	 * x^(2^k - 1) for the block lengths k it needs, using 253 squarings and 13 multiplications in total.
+	 */
+	countOps(functionOps);
+	const FieldInt &x1 = *this;
+	FieldInt x2 = x1;
+	x2.squareRepeatMultiply(1, x1);
+	FieldInt x3 = x2;
+	x3.squareRepeatMultiply(1, x1);
+	FieldInt x6 = x3;
+	x6.squareRepeatMultiply(3, x3);
+	FieldInt x9 = x6;
+	x9.squareRepeatMultiply(3, x3);
+	FieldInt x11 = x9;
+	x11.squareRepeatMultiply(2, x2);
+	FieldInt x22 = x11;
+	x22.squareRepeatMultiply(11, x11);
+	FieldInt x44 = x22;
+	x44.squareRepeatMultiply(22, x22);
+	FieldInt x88 = x44;
+	x88.squareRepeatMultiply(44, x44);
+	FieldInt result = x88;
+	result.squareRepeatMultiply(88, x88);  // 176 ones
+	result.squareRepeatMultiply(44, x44);  // 220 ones
+	result.squareRepeatMultiply(3, x3);    // 223 ones
+	result.squareRepeatMultiply(23, x22);
+	result.squareRepeatMultiply(6, x2);
+	result.square();
+	result.square();
+	
+	FieldInt check = result;
+	check.square();
+	bool isSquare = check == *this;
+	this->replace(result, static_cast<uint32_t>(isSquare));
+	countOps(11 * fieldintCopyOps);
+	return isSquare;
+}
+
+
+void FieldInt::squareRepeatMultiply(int n, const FieldInt &other) {
+	countOps(functionOps);
+	for (int i = 0; i < n; i++) {
+		countOps(loopBodyOps);
+		square();
+	}
+	multiply(other);
+}
+
+
 void FieldInt::replace(const FieldInt &other, uint32_t enable) {
 	countOps(functionOps);
 	Uint256::replace(other, enable);
@@ -8,10 +8,19 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include "Uint256.hpp"
 
 
+// Define FIELDINT_5X52 to compute multiply() and square() on 5 limbs of 52 bits with 64x64 -> 128-bit products
+// and a reduction specific to the modulus, instead of 8 limbs of 32 bits with Barrett reduction. The stored
+// representation and the public API stay the same. Requires a 64-bit compiler with unsigned __int128.
+#if defined(FIELDINT_5X52) && !defined(__SIZEOF_INT128__)
+	#error "FIELDINT_5X52 requires unsigned __int128"
+#endif
+
+
 /* 
  * An unsigned 256-bit integer modulo a specific prime number, for Bitcoin and secp256k1.
  * The input and output values of each method are always in the range [0, MODULUS).
@@ -71,6 +80,38 @@ class FieldInt final : private Uint256 {
 	public: void reciprocal();
 	
 	
+	// Computes the multiplicative inverse of this number with respect to the modulus.
+	// If this number is zero, the reciprocal is zero. Not constant-time; only use it on public values.
+	public: void reciprocalVar();
+	
+	
+	// Replaces each of the given numbers with its multiplicative inverse with respect to the modulus, with the same
+	// results as calling reciprocal() on each one (zero stays zero), but using a single inversion and 3 multiplications
+	// per number (Montgomery's trick). The scratch array must have room for len numbers; its contents on return
+	// are unspecified. Constant-time with respect to the values, but not the length.
+	public: static void reciprocalBatch(FieldInt vals[], std::size_t len, FieldInt scratch[]);
+	
+	
+	// Replaces each of the given numbers with its multiplicative inverse, with the same results and scratch
+	// requirement as reciprocalBatch(). Zero values are skipped. Not constant-time; only use it on public values.
+	public: static void reciprocalBatchVar(FieldInt vals[], std::size_t len, FieldInt scratch[]);
+	
+	
+	// Returns the Legendre symbol of this number: 1 if it is a nonzero square,
+	// -1 if it is a non-square, or 0 if it is zero. Not constant-time.
+	public: int jacobiVar() const;
+	
+	
+	// If this number is a square modulo the prime, sets it to one of its square roots (the other one is its negation)
+	// and returns true. Otherwise leaves this number unchanged and returns false. Constant-time with respect to this value.
+	public: bool sqrt();
+	
+	
+	// Sets this number to this^(2^n) * other, modulo the prime. A step of the addition chain in sqrt().
+	// Constant-time with respect to both values.
+	private: void squareRepeatMultiply(int n, const FieldInt &other);
+	
+	
 	/*---- Miscellaneous methods ----*/
 	
 	public: void replace(const FieldInt &other, std::uint32_t enable);
@@ -96,9 +137,27 @@ class FieldInt final : private Uint256 {
 	private: bool operator<(const Uint256 &other) const;
 	
 	private: bool operator>=(const Uint256 &other) const;
+
+
+#if defined(FIELDINT_5X52)
+	/*---- Helper functions for the 5x52 backend ----*/
+	
+	// Splits this number into limbs of 52, 52, 52, 52, and 48 bits, in little endian.
+	private: void toLimbs52(std::uint64_t limbs[5]) const;
 	
 	
+	// Sets this number to the given uncarried product columns (column i has weight 2^(52*i), and each is
+	// less than 2^108) reduced modulo the prime. Constant-time with respect to the values.
+	private: void reduceColumns52(const unsigned __int128 columns[9]);
+#else
+	/*---- Helper functions ----*/
 	
+	// Sets this number to the given 512-bit product (little endian) reduced modulo the prime.
+	// Constant-time with respect to the value.
+	private: void reduce512(const std::uint32_t product[NUM_WORDS * 2]);
+#endif
+
+
 	/*---- Class constants ----*/
 	
 	private: static const Uint256 MODULUS;  // Prime number
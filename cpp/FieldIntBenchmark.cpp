@@ -0,0 +1,52 @@
+/* 
+ * A runnable main program that measures and prints the wall-clock time of
+ * the core FieldInt operations, for comparing field arithmetic backends
+ * (the default build, -DFIELDINT_5X52, and the x8664 directory).
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "FieldInt.hpp"
+
+
+static const long ITERATIONS = 1000000;
+static const int TRIALS = 5;
+
+static volatile std::uint32_t sink;  // Keeps the compiler from discarding the results
+
+
+// Returns the fastest of a few trials of the given operation, in nanoseconds per call.
+template <typename Func>
+static double benchmark(Func func) {
+	double best = -1;
+	for (int i = 0; i < TRIALS; i++) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (long j = 0; j < ITERATIONS; j++)
+			func();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		double time = elapsed.count() / ITERATIONS;
+		if (best < 0 || time < best)
+			best = time;
+	}
+	return best;
+}
+
+
+int main() {
+	const FieldInt y("15528860FDA6A013614A58B7A80791AA6903CAC1C0BFFF13C0BFE6D80040B7DC");
+	FieldInt x("3D2602F0F70649CD7E03254326F24DECC79A7040A948AD5A21D97F3AE82A2AF9");
+	
+	std::printf("%10.1f ns  fiMultiply\n", benchmark([&]() { x.multiply(y); }));
+	std::printf("%10.1f ns  fiSquare\n"  , benchmark([&]() { x.square(); }));
+	std::printf("%10.1f ns  fiAdd\n"     , benchmark([&]() { x.add(y); }));
+	sink = x.value[0];
+	return EXIT_SUCCESS;
+}
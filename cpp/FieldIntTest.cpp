@@ -27,6 +27,11 @@ struct TernaryCase {
 	const char *z;
 };
 
+struct JacobiCase {
+	const char *x;
+	int y;
+};
+
 
 // Global variables
 static int numTestCases = 0;
@@ -265,6 +270,109 @@ static void testReciprocal() {
 		assert(x == FieldInt(tc.y));
 		numTestCases++;
 	}
+	for (const BinaryCase &tc : cases) {
+		FieldInt x(tc.x);
+		x.reciprocalVar();
+		assert(x == FieldInt(tc.y));
+		numTestCases++;
+	}
+	
+	// Batches of every length, including the zero case and empty batches
+	for (std::size_t len = 0; len <= cases.size(); len++) {
+		for (int variant = 0; variant < 2; variant++) {
+			vector<FieldInt> vals;
+			vector<FieldInt> scratch;
+			for (std::size_t i = 0; i < len; i++) {
+				vals.push_back(FieldInt(cases.at(cases.size() - 1 - i).x));
+				scratch.push_back(FieldInt(Uint256::ZERO));
+			}
+			if (variant == 0)
+				FieldInt::reciprocalBatch(vals.data(), len, scratch.data());
+			else
+				FieldInt::reciprocalBatchVar(vals.data(), len, scratch.data());
+			for (std::size_t i = 0; i < len; i++)
+				assert(vals.at(i) == FieldInt(cases.at(cases.size() - 1 - i).y));
+			numTestCases++;
+		}
+	}
+}
+
+
+static void testJacobiVar() {
+	const vector<JacobiCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000000", 0},
+		{"0000000000000000000000000000000000000000000000000000000000000001", 1},
+		{"0000000000000000000000000000000000000000000000000000000000000002", 1},
+		{"0000000000000000000000000000000000000000000000000000000000000003", -1},
+		{"0000000000000000000000000000000000000000000000000000000000000004", 1},
+		{"0000000000000000000000000000000000000000000000000000000000000007", -1},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2E", -1},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2D", -1},
+		{"8000000000000000000000000000000000000000000000000000000000000000", 1},
+		{"79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", 1},
+		{"0B3510B0B46EE1DA317017A6205738D16018366CF658F7A75ED34FE53A096533", 1},
+		{"6694F229359B154881A0D5B3FFC6E35CCFAF00103F584AD4230824D215CEB3A1", -1},
+		{"92B850AD7EB72F8263F65DA874007CB47CC661E97589CA4A07C15471A4517D6C", 1},
+		{"C24F6AA83BF36A147C2F7AD016EDC5D467164890D49D0AC1E5B8063831360A40", -1},
+		{"E941AA79E6EDAF80796D3BC4685CA8AF852A5FBA444ADF42B37F5722051E2670", -1},
+		{"D0718C1AFDD9A78D18DFF3934223AA56A9B7E3EA1D1D784FB9DB434B610B1631", 1},
+		{"0EDCA4ECA92D04A31B941F4360908405D45C39A39EC353C162E917D310269470", 1},
+		{"844DBC0CA65423A9E744B24E7F61701E1607B1C4B0F913063C02E56756A3E957", 1},
+		{"8A2AD16E107AC8069B51C6322463278ECEF2D30194DF943C353A0106E6C08269", 1},
+		{"DC3D716BF22FF5FD25F0F21231A06A7CB3AA75AB7D1944FF09974B85F2306D4A", 1},
+		{"8EAC871F492091F271F47E49E18692E295990881BA9BE85A74CDA9C49436D6F6", -1},
+		{"99EF936AC3A8DB5628865529228DC5196D16328FE0C99F3EDAE3DF9C5B507A36", -1},
+		{"A4D70DFCF3332EB05B6659EAB3BFCD5D50545214B0AFB81E8824918818FD64F7", -1},
+		{"5B11B76F2670E0984F0CF267329911DA9FBD873580ED55037EA03260D7EF27BB", 1},
+		{"DB522231E7397785CEE116191248A2A4A834D5808281A6BF48CB74A9875A34F2", 1},
+		{"E86C68CD3E6F54D4581DA689384EF90A8B80EB31B3880DE0E9BE9F8881E6187F", -1},
+		{"4138CAD26C64107F089D8567444FC6F938443E4F57DE014C4BB36EC8030CF05D", 1},
+		{"A84E090A2CDD3FBE6ABB3E13E4373A7DB494D2A8D595BF234C60DED1607E39D1", 1},
+		{"068FE849F98F7A0DDA23CEA1A9C59A2DEEBB31672A8AE1661DC35C7F65718DDC", 1},
+		{"CBE20B1103623AE41DD1D6164CCFBBBF2922071DC437B057F91B60E533A9B4BB", -1},
+	};
+	for (const JacobiCase &tc : cases) {
+		assert(FieldInt(tc.x).jacobiVar() == tc.y);
+		numTestCases++;
+	}
+}
+
+
+static void testSqrt() {
+	const vector<const char *> cases{
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"0000000000000000000000000000000000000000000000000000000000000002",
+		"0000000000000000000000000000000000000000000000000000000000000003",
+		"0000000000000000000000000000000000000000000000000000000000000007",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2E",
+		"79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798",
+		"6694F229359B154881A0D5B3FFC6E35CCFAF00103F584AD4230824D215CEB3A1",
+		"92B850AD7EB72F8263F65DA874007CB47CC661E97589CA4A07C15471A4517D6C",
+		"C24F6AA83BF36A147C2F7AD016EDC5D467164890D49D0AC1E5B8063831360A40",
+		"D0718C1AFDD9A78D18DFF3934223AA56A9B7E3EA1D1D784FB9DB434B610B1631",
+		"E86C68CD3E6F54D4581DA689384EF90A8B80EB31B3880DE0E9BE9F8881E6187F",
+	};
+	for (const char *tc : cases) {
+		// Exactly the numbers with a nonnegative Legendre symbol have square roots
+		const FieldInt x(tc);
+		FieldInt y = x;
+		bool ok = y.sqrt();
+		assert(ok == (x.jacobiVar() >= 0));
+		if (ok)
+			y.square();
+		assert(y == x);  // Unchanged if there is no root
+		
+		// The square of any number is a square, and its root is that number or its negation
+		FieldInt sq = x;
+		sq.square();
+		FieldInt root = sq;
+		assert(root.sqrt());
+		FieldInt neg(Uint256::ZERO);
+		neg.subtract(x);
+		assert(root == x || root == neg);
+		numTestCases++;
+	}
 }
 
 
@@ -293,6 +401,8 @@ int main() {
 	testMultiply();
 	testSquare();
 	testReciprocal();
+	testJacobiVar();
+	testSqrt();
 	testConstructorUint256();
 	std::printf("All %d test cases passed\n", numTestCases);
 	return EXIT_SUCCESS;
@@ -0,0 +1,294 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include "CountOps.hpp"
+#include "JacobianPoint.hpp"
+
+using std::uint32_t;
+
+
+JacobianPoint::JacobianPoint() :
+	x(Uint256::ZERO), y(Uint256::ONE), z(Uint256::ZERO) {}
+
+
+JacobianPoint::JacobianPoint(const FieldInt &x_, const FieldInt &y_, const FieldInt &z_) :
+	x(x_), y(y_), z(z_) {}
+
+
+JacobianPoint::JacobianPoint(const CurvePoint &p) :
+		x(p.x), y(p.y), z(p.z) {
+	// (X / Z, Y / Z) = (X * Z / Z^2, Y * Z^2 / Z^3)
+	countOps(functionOps);
+	FieldInt zz = z;
+	zz.square();
+	x.multiply(z);
+	y.multiply(zz);
+	countOps(1 * fieldintCopyOps);
+}
+
+
+JacobianPoint::JacobianPoint(const AffinePoint &p) :
+		x(p.x), y(p.y), z(Uint256::ONE) {
+	countOps(functionOps);
+	z.replace(CurvePoint::FI_ZERO, static_cast<uint32_t>(p.isZero()));
+}
+
+
+void JacobianPoint::addVar(const JacobianPoint &other) {
+	countOps(functionOps);
+	if (other.isZero())
+		return;
+	if (isZero()) {
+		*this = other;
+		countOps(1 * curvepointCopyOps);
+		return;
+	}
+	const JacobianPoint orig = *this;
+	bool sameX, sameY;
+	addUnchecked(*this, other.x, other.y, &other.z, sameX, sameY);
+	if (sameX && sameY) {
+		*this = orig;
+		twice();
+		countOps(1 * curvepointCopyOps);
+	}
+	countOps(2 * arithmeticOps);
+	countOps(1 * curvepointCopyOps);
+}
+
+
+void JacobianPoint::addMixedVar(const AffinePoint &other) {
+	countOps(functionOps);
+	if (other.isZero())
+		return;
+	if (isZero()) {
+		*this = JacobianPoint(other);
+		countOps(1 * curvepointCopyOps);
+		return;
+	}
+	const JacobianPoint orig = *this;
+	bool sameX, sameY;
+	addUnchecked(*this, other.x, other.y, nullptr, sameX, sameY);
+	if (sameX && sameY) {
+		*this = orig;
+		twice();
+		countOps(1 * curvepointCopyOps);
+	}
+	countOps(2 * arithmeticOps);
+	countOps(1 * curvepointCopyOps);
+}
+
+
+void JacobianPoint::twice() {
+	/* 
+	 * dbl-2009-l (see https://hyperelliptic.org/EFD/g1p/auto-shortw-jacobian-0.html)
+	 * Algorithm pseudocode:
+	 * a = x^2
+	 * b = y^2
+	 * c = b^2
+	 * d = 2 * ((x + b)^2 - a - c)
+	 * e = 3 * a
+	 * x' = e^2 - 2 * d
+	 * y' = e * (d - x') - 8 * c
+	 * z' = 2 * y * z
+	 */
+	countOps(functionOps);
+	FieldInt a = x;
+	a.square();
+	FieldInt b = y;
+	b.square();
+	FieldInt c = b;
+	c.square();
+	FieldInt d = x;
+	d.add(b);
+	d.square();
+	d.subtract(a);
+	d.subtract(c);
+	d.multiply2();
+	FieldInt &e = b;  // Reuse memory
+	e = a;
+	e.multiply2();
+	e.add(a);
+	
+	z.multiply(y);
+	z.multiply2();
+	x = e;
+	x.square();
+	x.subtract(d);
+	x.subtract(d);
+	y = d;
+	y.subtract(x);
+	y.multiply(e);
+	c.multiply2();
+	c.multiply2();
+	c.multiply2();
+	y.subtract(c);
+	countOps(8 * fieldintCopyOps);
+}
+
+
+void JacobianPoint::negate(uint32_t enable) {
+	assert((enable >> 1) == 0);
+	countOps(functionOps);
+	FieldInt negY = CurvePoint::FI_ZERO;
+	negY.subtract(y);
+	y.replace(negY, enable);
+	countOps(1 * fieldintCopyOps);
+}
+
+
+bool JacobianPoint::isZero() const {
+	countOps(functionOps);
+	return z == CurvePoint::FI_ZERO;
+}
+
+
+CurvePoint JacobianPoint::toCurvePoint() const {
+	countOps(functionOps);
+	FieldInt px = x;
+	px.multiply(z);
+	CurvePoint result(px, y);
+	result.z = z;
+	result.z.square();
+	result.z.multiply(z);
+	result.replace(CurvePoint::ZERO, static_cast<uint32_t>(isZero()));
+	countOps(2 * fieldintCopyOps);
+	countOps(1 * curvepointCopyOps);
+	return result;
+}
+
+
+void JacobianPoint::toAffineBatchVar(const JacobianPoint in[], AffinePoint out[], std::size_t len) {
+	/* 
+	 * Montgomery's trick: with p[i] = z[0] * ... * z[i] (skipping zero points), invert only p[len-1],
+	 * then walk backward: 1/z[i] = 1/p[i] * p[i-1], and 1/p[i-1] = 1/p[i] * z[i]. The prefix products
+	 * are kept in out[i].x until they are consumed.
+	 */
+	countOps(functionOps);
+	FieldInt acc = CurvePoint::FI_ONE;
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		if (!in[i].isZero())
+			acc.multiply(in[i].z);
+		out[i].x = acc;
+		countOps(1 * fieldintCopyOps);
+	}
+	acc.reciprocalVar();
+	for (std::size_t i = len; i-- > 0; ) {
+		countOps(loopBodyOps);
+		if (in[i].isZero()) {
+			out[i] = AffinePoint::ZERO;
+			countOps(2 * fieldintCopyOps);
+			continue;
+		}
+		FieldInt inv = acc;
+		if (i > 0)
+			inv.multiply(out[i - 1].x);
+		acc.multiply(in[i].z);
+		
+		FieldInt inv2 = inv;
+		inv2.square();
+		out[i].x = in[i].x;
+		out[i].x.multiply(inv2);
+		inv2.multiply(inv);
+		out[i].y = in[i].y;
+		out[i].y.multiply(inv2);
+		countOps(4 * fieldintCopyOps);
+	}
+}
+
+
+void JacobianPoint::addUnchecked(JacobianPoint &p, const FieldInt &qx, const FieldInt &qy,
+		const FieldInt *qz, bool &sameX, bool &sameY) {
+	/* 
+	 * add-2007-bl, or madd-2007-bl when q.z = 1 (see https://hyperelliptic.org/EFD/g1p/auto-shortw-jacobian-0.html)
+	 * Algorithm pseudocode:
+	 * u1 = p.x * q.z^2;  s1 = p.y * q.z^3
+	 * u2 = q.x * p.z^2;  s2 = q.y * p.z^3
+	 * h = u2 - u1
+	 * i = (2 * h)^2
+	 * j = h * i
+	 * r = 2 * (s2 - s1)
+	 * v = u1 * i
+	 * x' = r^2 - j - 2 * v
+	 * y' = r * (v - x') - 2 * s1 * j
+	 * z' = ((p.z + q.z)^2 - p.z^2 - q.z^2) * h, which is 2 * p.z * q.z * h
+	 */
+	countOps(functionOps);
+	FieldInt z1z1 = p.z;
+	z1z1.square();
+	FieldInt u1 = p.x;
+	FieldInt s1 = p.y;
+	FieldInt u2 = qx;
+	u2.multiply(z1z1);
+	FieldInt s2 = qy;
+	s2.multiply(p.z);
+	s2.multiply(z1z1);
+	FieldInt z3 = p.z;
+	FieldInt h = u2;
+	FieldInt i = h;
+	if (qz != nullptr) {  // Depends only on which method was called
+		FieldInt z2z2 = *qz;
+		z2z2.square();
+		u1.multiply(z2z2);
+		s1.multiply(*qz);
+		s1.multiply(z2z2);
+		h.subtract(u1);
+		i = h;
+		i.multiply2();
+		i.square();
+		z3.add(*qz);
+		z3.square();
+		z3.subtract(z1z1);
+		z3.subtract(z2z2);
+		z3.multiply(h);
+		countOps(1 * fieldintCopyOps);
+	} else {  // madd-2007-bl: z' = (p.z + h)^2 - p.z^2 - h^2, i = 4 * h^2
+		h.subtract(u1);
+		i = h;
+		i.square();
+		z3.add(h);
+		z3.square();
+		z3.subtract(z1z1);
+		z3.subtract(i);
+		i.multiply2();
+		i.multiply2();
+	}
+	FieldInt &j = u2;  // Reuse memory
+	j = h;
+	j.multiply(i);
+	FieldInt &r = s2;  // Reuse memory
+	r.subtract(s1);
+	r.multiply2();
+	sameX = h == CurvePoint::FI_ZERO;
+	sameY = r == CurvePoint::FI_ZERO;
+	FieldInt &v = u1;  // Reuse memory
+	v.multiply(i);
+	
+	p.x = r;
+	p.x.square();
+	p.x.subtract(j);
+	p.x.subtract(v);
+	p.x.subtract(v);
+	p.y = v;
+	p.y.subtract(p.x);
+	p.y.multiply(r);
+	s1.multiply(j);
+	s1.multiply2();
+	p.y.subtract(s1);
+	p.z = z3;
+	countOps(2 * arithmeticOps);
+	countOps(12 * fieldintCopyOps);
+}
+
+
+// Static initializers
+const JacobianPoint JacobianPoint::ZERO(
+	FieldInt("0000000000000000000000000000000000000000000000000000000000000000"),
+	FieldInt("0000000000000000000000000000000000000000000000000000000000000001"),
+	FieldInt("0000000000000000000000000000000000000000000000000000000000000000"));
@@ -0,0 +1,103 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "AffinePoint.hpp"
+#include "CurvePoint.hpp"
+#include "FieldInt.hpp"
+
+
+/* 
+ * A point on the secp256k1 elliptic curve in Jacobian coordinates, whose affine coordinates are (x/z^2, y/z^3).
+ * This is the accumulator type of the variable-time scalar multiplication paths in CurvePoint and PreparedPublicKey:
+ * because the curve has a = 0, doubling costs 2 multiplications and 5 squarings (dbl-2009-l), and adding an
+ * AffinePoint costs 7 multiplications and 4 squarings (madd-2007-bl). The additions branch on zero and equal
+ * points, so the constant-time paths use CurvePoint's complete projective formulas instead. The point at
+ * infinity is any point with z = 0. Instances of this class are mutable.
+ */
+class JacobianPoint final {
+	
+	/*---- Fields ----*/
+	
+	public: FieldInt x;
+	public: FieldInt y;
+	public: FieldInt z;  // The point is zero iff z = 0
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Constructs the point at infinity. Constant-time.
+	public: explicit JacobianPoint();
+	
+	
+	// Constructs a point from the given Jacobian coordinates. Constant-time with respect to the values.
+	public: explicit JacobianPoint(const FieldInt &x_, const FieldInt &y_, const FieldInt &z_);
+	
+	
+	// Converts the given projective point, which need not be normalized. Constant-time with respect to the value.
+	public: explicit JacobianPoint(const CurvePoint &p);
+	
+	
+	// Converts the given affine point (possibly the point at infinity). Constant-time with respect to the value.
+	public: explicit JacobianPoint(const AffinePoint &p);
+	
+	
+	
+	/*---- Arithmetic methods ----*/
+	
+	// Adds the given point to this point, handling zero, equal and opposite points. Not constant-time.
+	public: void addVar(const JacobianPoint &other);
+	
+	
+	// Adds the given affine point to this point, handling zero, equal and opposite points. Not constant-time.
+	public: void addMixedVar(const AffinePoint &other);
+	
+	
+	// Doubles this point. The formula needs no special cases, because zero stays zero
+	// and no point on the curve has y = 0. Constant-time with respect to this value.
+	public: void twice();
+	
+	
+	// Negates this point (y becomes -y) if enable is 1, or does nothing if enable is 0.
+	// Constant-time with respect to both values.
+	public: void negate(std::uint32_t enable=1);
+	
+	
+	// Tests whether this point is the point at infinity. Constant-time with respect to this value.
+	public: bool isZero() const;
+	
+	
+	// Returns this point in projective coordinates (usually not normalized), as (x * z, y, z^3).
+	// Constant-time with respect to this value.
+	public: CurvePoint toCurvePoint() const;
+	
+	
+	/*---- Static functions ----*/
+	
+	// Converts the len given points to affine coordinates with a single field inversion (Montgomery's trick),
+	// mapping zero points to AffinePoint::ZERO. The arrays must not overlap. Not constant-time.
+	public: static void toAffineBatchVar(const JacobianPoint in[], AffinePoint out[], std::size_t len);
+	
+	
+	// Computes the coordinates of the sum of p and q by madd-2007-bl (if qz is nullptr, meaning q is affine) or
+	// add-2007-bl, without handling special cases. Sets sameX and sameY to whether p and q have equal affine x
+	// and y coordinates; if they are both true then the result is invalid, and if only sameX is true then the
+	// result has z = 0. Constant-time with respect to all values.
+	private: static void addUnchecked(JacobianPoint &p, const FieldInt &qx, const FieldInt &qy,
+		const FieldInt *qz, bool &sameX, bool &sameY);
+	
+	
+	/*---- Class constants ----*/
+	
+	public: static const JacobianPoint ZERO;  // Point at infinity, (0, 1, 0)
+	
+};
@@ -0,0 +1,176 @@
+/* 
+ * A runnable main program that tests the functionality of classes JacobianPoint and AffinePoint.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "TestHelper.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include "AffinePoint.hpp"
+#include "CurvePoint.hpp"
+#include "FieldInt.hpp"
+#include "JacobianPoint.hpp"
+#include "Uint256.hpp"
+
+
+// Global variables
+static int numTestCases = 0;
+
+
+/*---- Helper functions ----*/
+
+// Returns a list of points covering the special cases: zero, equal points, and opposite points.
+// Every other point has a nontrivial Jacobian z coordinate.
+static vector<JacobianPoint> makePoints() {
+	const vector<const char *> privateKeys{
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"0000000000000000000000000000000000000000000000000000000000000002",
+		"0000000000000000000000000000000000000000000000000000000000000003",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+		"B2160535D43F02A4FB5C13236BBDB09BFE25AAC9C4E18344C7E607FC1AD2FB16",
+		"9C43481D06F763D2D5DB07E29931A0EFAD2F0499A2482454187E1D18F4AFA9A1",
+	};
+	vector<JacobianPoint> result{JacobianPoint()};
+	for (const char *privKey : privateKeys) {
+		// Compute 2 * (privKey / 2 mod order) * G, so that z is not 1
+		Uint256 half(privKey);
+		if ((half.value[0] & 1) != 0)
+			half.add(CurvePoint::ORDER);  // Cannot overflow because privKey < order
+		half.shiftRight1();
+		JacobianPoint p(CurvePoint::privateExponentToPublicPoint(half));
+		p.twice();
+		result.push_back(p);
+	}
+	return result;
+}
+
+
+static CurvePoint toNormalized(const JacobianPoint &p) {
+	CurvePoint result = p.toCurvePoint();
+	result.normalize();
+	return result;
+}
+
+
+static AffinePoint toAffine(const CurvePoint &p) {
+	CurvePoint q = p;
+	q.normalize();
+	return q.isZero() ? AffinePoint::ZERO : AffinePoint(q.x, q.y);
+}
+
+
+/*---- Test cases ----*/
+
+static void testConversions() {
+	const vector<JacobianPoint> points = makePoints();
+	for (const JacobianPoint &p : points) {
+		CurvePoint expect = toNormalized(p);
+		assert(p.isZero() == expect.isZero());
+		
+		// Round trip through projective and affine coordinates
+		JacobianPoint q(p.toCurvePoint());
+		assert(toNormalized(q) == expect);
+		JacobianPoint r(toAffine(expect));
+		assert(toNormalized(r) == expect);
+		if (!expect.isZero())
+			assert(r.z == CurvePoint::FI_ONE);
+		numTestCases++;
+	}
+	assert(AffinePoint().isZero() && AffinePoint::ZERO.isZero() && JacobianPoint::ZERO.isZero());
+	assert(!AffinePoint(CurvePoint::G.x, CurvePoint::G.y).isZero());
+	assert(JacobianPoint(AffinePoint::ZERO).isZero());
+	assert(JacobianPoint(CurvePoint::ZERO).isZero());
+	numTestCases++;
+}
+
+
+static void testTwice() {
+	for (const JacobianPoint &p : makePoints()) {
+		CurvePoint expect = p.toCurvePoint();
+		expect.twice();
+		expect.normalize();
+		JacobianPoint actual = p;
+		actual.twice();
+		assert(toNormalized(actual) == expect);
+		numTestCases++;
+	}
+}
+
+
+static void testNegate() {
+	for (const JacobianPoint &p : makePoints()) {
+		for (uint32_t enable = 0; enable < 2; enable++) {
+			CurvePoint expect = p.toCurvePoint();
+			expect.negate(enable);
+			expect.normalize();
+			JacobianPoint actual = p;
+			actual.negate(enable);
+			assert(toNormalized(actual) == expect);
+			AffinePoint affine = toAffine(p.toCurvePoint());
+			affine.negate(enable);
+			assert(toNormalized(JacobianPoint(affine)) == expect);
+			numTestCases++;
+		}
+	}
+}
+
+
+static void testAdd() {
+	// Every pair of points, including their negations, so that equal and opposite pairs are covered
+	vector<JacobianPoint> points = makePoints();
+	const std::size_t len = points.size();
+	for (std::size_t i = 0; i < len; i++) {
+		JacobianPoint neg = points.at(i);
+		neg.negate();
+		points.push_back(neg);
+	}
+	for (const JacobianPoint &p : points) {
+		for (const JacobianPoint &q : points) {
+			CurvePoint expect = p.toCurvePoint();
+			expect.add(q.toCurvePoint());
+			expect.normalize();
+			const AffinePoint qAffine = toAffine(q.toCurvePoint());
+			for (int i = 0; i < 2; i++) {
+				JacobianPoint actual = p;
+				if (i == 0)
+					actual.addVar(q);
+				else
+					actual.addMixedVar(qAffine);
+				assert(toNormalized(actual) == expect);
+				numTestCases++;
+			}
+		}
+	}
+}
+
+
+static void testToAffineBatch() {
+	vector<JacobianPoint> points = makePoints();
+	points.push_back(JacobianPoint());  // Zeros at both ends and in the middle
+	points.insert(points.begin() + 3, JacobianPoint());
+	for (std::size_t len = 0; len <= points.size(); len++) {
+		vector<AffinePoint> out(len);
+		JacobianPoint::toAffineBatchVar(points.data(), out.data(), len);
+		for (std::size_t j = 0; j < len; j++) {
+			const AffinePoint expect = toAffine(points.at(j).toCurvePoint());
+			assert(out.at(j).x == expect.x && out.at(j).y == expect.y);
+		}
+		numTestCases++;
+	}
+}
+
+
+int main() {
+	testConversions();
+	testTwice();
+	testNegate();
+	testAdd();
+	testToAffineBatch();
+	std::printf("All %d test cases passed\n", numTestCases);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,72 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include "MultiplySumScratch.hpp"
+
+using std::size_t;
+using std::uint64_t;
+
+
+MultiplySumScratch::MultiplySumScratch(size_t maxLen_, unsigned int numThreads_) :
+		maxLen(maxLen_),
+		numThreads(numThreads_ != 0 ? numThreads_ : std::max(std::thread::hardware_concurrency(), 1u)) {
+	constexpr int wnafTableLen = 1 << (WNAF_WINDOW_BITS - 2);
+	size_t straussLen = maxLen < STRAUSS_MAX_LEN ? maxLen : STRAUSS_MAX_LEN;
+	wnafDigits.resize(straussLen * 2 * (Uint256::NUM_WORDS * 32 + 1));
+	multiples.resize(straussLen * wnafTableLen);
+	tables.resize(straussLen * 2 * wnafTableLen);
+	lambdaNegs.resize(straussLen);
+	if (maxLen <= STRAUSS_MAX_LEN)
+		return;
+	
+	// The window width only grows with the length, so the shortest Pippenger sum has the most windows
+	// and the longest one has the most buckets
+	int maxWindows = getNumWindows(getWindowBits((STRAUSS_MAX_LEN + 1) * 2));
+	size_t maxBuckets = static_cast<size_t>(1) << (getWindowBits(maxLen * 2) - 1);
+	normalized.resize(maxLen, CurvePoint::ZERO);
+	terms.resize(maxLen * 2);
+	digits.resize(maxLen * 2 * maxWindows);
+	windowSums.resize(maxWindows);
+	sorted.resize(numThreads * maxLen * 2);
+	denominators.resize(numThreads * maxLen, CurvePoint::FI_ZERO);
+	inverseScratch.resize(numThreads * maxLen, CurvePoint::FI_ZERO);
+	bucketStarts.resize(numThreads * (maxBuckets + 1));
+	bucketLens.resize(numThreads * maxBuckets);
+}
+
+
+size_t MultiplySumScratch::getMaxLen() const {
+	return maxLen;
+}
+
+
+unsigned int MultiplySumScratch::getNumThreads() const {
+	return numThreads;
+}
+
+
+int MultiplySumScratch::getWindowBits(size_t numTerms) {
+	int result = 2;
+	uint64_t bestCost = UINT64_MAX;
+	for (int bits = 2; bits <= MAX_WINDOW_BITS; bits++) {
+		uint64_t cost = static_cast<uint64_t>(getNumWindows(bits)) * (6 * static_cast<uint64_t>(numTerms) + (UINT64_C(27) << (bits - 1)));
+		if (cost < bestCost) {
+			result = bits;
+			bestCost = cost;
+		}
+	}
+	return result;
+}
+
+
+int MultiplySumScratch::getNumWindows(int windowBits) {
+	return 128 / windowBits + 1;
+}
@@ -0,0 +1,94 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AffinePoint.hpp"
+#include "CurvePoint.hpp"
+#include "FieldInt.hpp"
+#include "JacobianPoint.hpp"
+
+
+/* 
+ * Caller-owned working memory for CurvePoint::multiplySumVar() with a scratch argument, so that repeated
+ * multi-scalar multiplications (such as batch verification or aggregation) allocate nothing. Construct one
+ * for the largest number of terms and the number of threads to use, and then pass it to any number of calls
+ * of up to that many terms. One instance must not be used by concurrent calls. Instances are mutable.
+ */
+class MultiplySumScratch final {
+	
+	/*---- Public constants ----*/
+	
+	// Sums of at most this many terms use the interleaved wNAF (Strauss) method; longer ones use Pippenger's buckets
+	public: static constexpr std::size_t STRAUSS_MAX_LEN = 24;
+	
+	
+	
+	/*---- Fields ----*/
+	
+	private: std::size_t maxLen;
+	private: unsigned int numThreads;
+	
+	// For the Strauss method (for at most STRAUSS_MAX_LEN terms)
+	private: std::vector<std::int8_t> wnafDigits;  // 2 * 257 per term
+	private: std::vector<JacobianPoint> multiples;  // WNAF_TABLE_LEN per term
+	private: std::vector<AffinePoint> tables;  // 2 * WNAF_TABLE_LEN per term
+	private: std::vector<std::uint32_t> lambdaNegs;  // 1 per term
+	
+	// For the Pippenger method, shared by all threads
+	private: std::vector<CurvePoint> normalized;  // 1 per term
+	private: std::vector<AffinePoint> terms;  // 2 per term (the GLV halves)
+	private: std::vector<std::int16_t> digits;  // 2 per term per window
+	private: std::vector<JacobianPoint> windowSums;  // 1 per window
+	
+	// For the Pippenger method, one slice per thread
+	private: std::vector<AffinePoint> sorted;  // 2 per term
+	private: std::vector<FieldInt> denominators;  // 1 per term
+	private: std::vector<FieldInt> inverseScratch;  // 1 per term
+	private: std::vector<std::uint32_t> bucketStarts;  // 1 per bucket, plus 1
+	private: std::vector<std::uint32_t> bucketLens;  // 1 per bucket
+	
+	
+	
+	/*---- Constructor ----*/
+	
+	// Allocates working memory for sums of up to maxLen terms, with the Pippenger windows split among numThreads
+	// threads (0 means one per hardware thread, and 1 means that no threads are started).
+	public: explicit MultiplySumScratch(std::size_t maxLen, unsigned int numThreads);
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Returns the largest number of terms that this scratch supports.
+	public: std::size_t getMaxLen() const;
+	
+	
+	// Returns the number of threads (at least 1) that Pippenger's method uses.
+	public: unsigned int getNumThreads() const;
+	
+	
+	// Returns the Pippenger window width in bits for the given number of GLV halves (twice the number of terms),
+	// minimizing the estimated field multiplications: about 6 per half per window for the batched affine additions
+	// into the buckets, and about 27 per bucket per window for the running-sum aggregation.
+	private: static int getWindowBits(std::size_t numTerms);
+	
+	
+	// Returns the number of signed windows of the given width that cover a 128-bit GLV half, including the carry.
+	private: static int getNumWindows(int windowBits);
+	
+	
+	private: static constexpr int MAX_WINDOW_BITS = 15;  // So that every signed digit fits in an int16_t
+	
+	
+	friend class CurvePoint;
+	
+};
@@ -0,0 +1,136 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include "CountOps.hpp"
+#include "PreparedPublicKey.hpp"
+#include "Scalar.hpp"
+
+using std::int8_t;
+
+
+PreparedPublicKey::PreparedPublicKey(const PublicKey &k) :
+		key(k) {
+	countOps(functionOps);
+	if (!key.isValid())
+		return;
+	
+	// Build the odd multiples in Jacobian coordinates, then convert them to affine with one inversion
+	const JacobianPoint p(key.getPoint());
+	JacobianPoint doubled = p;
+	doubled.twice();
+	std::vector<JacobianPoint> multiples;
+	multiples.reserve(TABLE_LEN);
+	multiples.push_back(p);
+	countOps(2 * curvepointCopyOps);
+	for (int i = 1; i < TABLE_LEN; i++) {
+		countOps(loopBodyOps);
+		multiples.push_back(multiples.back());
+		multiples.back().addVar(doubled);
+		countOps(1 * curvepointCopyOps);
+	}
+	table.resize(TABLE_LEN * 2);
+	JacobianPoint::toAffineBatchVar(multiples.data(), table.data(), TABLE_LEN);
+	for (int i = 0; i < TABLE_LEN; i++) {
+		countOps(loopBodyOps);
+		AffinePoint &q = table[static_cast<unsigned int>(TABLE_LEN + i)];
+		q = table[static_cast<unsigned int>(i)];
+		q.x.multiply(CurvePoint::BETA);
+		countOps(2 * fieldintCopyOps);
+	}
+}
+
+
+bool PreparedPublicKey::isValid() const {
+	return key.isValid();
+}
+
+
+const PublicKey &PreparedPublicKey::getKey() const {
+	return key;
+}
+
+
+CurvePoint PreparedPublicKey::multiplyAddVar(const PublicScalar &u1, const PreparedPublicKey &p, const PublicScalar &u2, const PreparedPublicKey &q) {
+	countOps(functionOps);
+	assert(p.isValid() && q.isValid());
+	int8_t digits1[2][257];
+	int8_t digits2[2][257];
+	int len1 = toSplitWnaf(u1, digits1);
+	int len2 = toSplitWnaf(u2, digits2);
+	
+	// Process all four halves from the most significant digit, sharing the doublings (interleaved wNAF)
+	JacobianPoint result;
+	bool isZero = true;  // Skip doubling the initial zero point
+	countOps(1 * curvepointCopyOps);
+	for (int i = (len1 > len2 ? len1 : len2) - 1; i >= 0; i--) {
+		countOps(loopBodyOps);
+		if (!isZero)
+			result.twice();
+		for (int j = 0; j < 2; j++) {
+			countOps(loopBodyOps);
+			if (digits1[j][i] != 0) {
+				p.addDigit(result, digits1[j][i], j == 1);
+				isZero = false;
+			}
+			if (digits2[j][i] != 0) {
+				q.addDigit(result, digits2[j][i], j == 1);
+				isZero = false;
+			}
+			countOps(6 * arithmeticOps);
+		}
+	}
+	return result.toCurvePoint();
+}
+
+
+const PreparedPublicKey &PreparedPublicKey::getGenerator() {
+	static const PreparedPublicKey result(PublicKey(CurvePoint::G));
+	return result;
+}
+
+
+void PreparedPublicKey::addDigit(JacobianPoint &point, int digit, bool useLambda) const {
+	countOps(functionOps);
+	assert(digit % 2 != 0 && -2 * TABLE_LEN < digit && digit < 2 * TABLE_LEN);
+	assert(table.size() == static_cast<unsigned int>(TABLE_LEN * 2));
+	unsigned int offset = useLambda ? TABLE_LEN : 0;
+	if (digit > 0)
+		point.addMixedVar(table[offset + static_cast<unsigned int>(digit - 1) / 2]);
+	else {
+		AffinePoint neg = table[offset + static_cast<unsigned int>(-digit - 1) / 2];
+		neg.negate();
+		point.addMixedVar(neg);
+		countOps(2 * fieldintCopyOps);
+	}
+	countOps(2 * arithmeticOps);
+}
+
+
+int PreparedPublicKey::toSplitWnaf(const PublicScalar &n, int8_t digits[2][257]) {
+	countOps(functionOps);
+	Scalar halves[2] = {Scalar(Uint256::ZERO), Scalar(Uint256::ZERO)};
+	Scalar::splitLambdaVar(Scalar(n.getValue()), halves[0], halves[1]);
+	int result = 0;
+	for (int i = 0; i < 2; i++) {
+		countOps(loopBodyOps);
+		Scalar neg = halves[i];
+		neg.negate();
+		bool isNeg = neg < halves[i];  // The magnitude is the smaller of r and order - r
+		int len = PublicScalar(isNeg ? neg : halves[i]).toWnaf(WINDOW_BITS, digits[i]);
+		if (isNeg) {
+			for (int j = 0; j < len; j++)
+				digits[i][j] = static_cast<int8_t>(-digits[i][j]);
+		}
+		if (len > result)
+			result = len;
+		countOps(4 * uint256CopyOps);
+		countOps(len * arithmeticOps);
+	}
+	return result;
+}
@@ -0,0 +1,80 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "AffinePoint.hpp"
+#include "CurvePoint.hpp"
+#include "JacobianPoint.hpp"
+#include "PublicKey.hpp"
+#include "PublicScalar.hpp"
+#include "Uint256.hpp"
+
+
+/* 
+ * A validated public key together with a precomputed table of its odd multiples, for verifying
+ * many signatures against the same key. Building the table costs about 16 point additions, once;
+ * afterwards each multiplication by the key splits the number into two 128-bit GLV halves in width-6
+ * wNAF (non-adjacent form), which needs 128 doublings and about 37 additions, and no table scans.
+ * All multiplications here are variable-time, so they must only be used on public data.
+ * Instances of this class are immutable.
+ */
+class PreparedPublicKey final {
+	
+	public: static constexpr int WINDOW_BITS = 6;  // wNAF width, with digits in the range (-2^5, 2^5)
+	public: static constexpr int TABLE_LEN = 1 << (WINDOW_BITS - 2);
+	
+	
+	/*---- Fields ----*/
+	
+	private: PublicKey key;
+	private: std::vector<AffinePoint> table;  // [1 * key, 3 * key, ..., 31 * key] then the same times LAMBDA, empty if the key is invalid
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Constructs a prepared key from the given validated key, building the table iff the key is valid.
+	public: explicit PreparedPublicKey(const PublicKey &k);
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Tests whether the underlying public key is valid.
+	public: bool isValid() const;
+	
+	
+	// Returns the underlying public key.
+	public: const PublicKey &getKey() const;
+	
+	
+	/*---- Static functions ----*/
+	
+	// Returns the point u1 * p + u2 * q, computed by splitting both numbers with the GLV endomorphism and
+	// processing the four halves with a single shared chain of at most 129 doublings, skipping zero digits.
+	// Both keys must be valid. The resulting state is usually not normalized. Not constant-time.
+	public: static CurvePoint multiplyAddVar(const PublicScalar &u1, const PreparedPublicKey &p, const PublicScalar &u2, const PreparedPublicKey &q);
+	
+	
+	// Returns the prepared base point CurvePoint::G, building it on the first call (thread-safe in C++11).
+	public: static const PreparedPublicKey &getGenerator();
+	
+	
+	// Adds table[(digit - 1) / 2] to the given point if digit > 0, or subtracts table[(-digit - 1) / 2] if digit < 0,
+	// using the half of the table that is multiplied by LAMBDA iff useLambda is true.
+	private: void addDigit(JacobianPoint &point, int digit, bool useLambda) const;
+	
+	
+	// Splits the given number into GLV halves (see Scalar::splitLambdaVar()) and writes the wNAF of each half's
+	// magnitude into digits[0] and digits[1], negating the digits of negative halves. Returns the longer length.
+	private: static int toSplitWnaf(const PublicScalar &n, std::int8_t digits[2][257]);
+	
+};
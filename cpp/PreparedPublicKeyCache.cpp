@@ -0,0 +1,43 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include "PreparedPublicKeyCache.hpp"
+
+
+PreparedPublicKeyCache::PreparedPublicKeyCache(std::size_t cap) :
+		capacity(cap),
+		invalid(PublicKey(CurvePoint::ZERO)) {
+	assert(cap > 0);
+}
+
+
+const PreparedPublicKey &PreparedPublicKeyCache::get(const PublicKey &key) {
+	if (!key.isValid())
+		return invalid;
+	CompressedPoint compressed;
+	key.getPoint().toCompressedPoint(compressed.data());
+	
+	auto it = index.find(compressed);
+	if (it != index.end()) {  // Hit: move to front
+		entries.splice(entries.begin(), entries, it->second);
+		return entries.front().second;
+	}
+	if (entries.size() >= capacity) {  // Evict the least recently used entry
+		index.erase(entries.back().first);
+		entries.pop_back();
+	}
+	entries.emplace_front(compressed, PreparedPublicKey(key));
+	index.emplace(compressed, entries.begin());
+	return entries.front().second;
+}
+
+
+std::size_t PreparedPublicKeyCache::size() const {
+	return entries.size();
+}
@@ -0,0 +1,59 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <utility>
+#include "PreparedPublicKey.hpp"
+#include "PublicKey.hpp"
+
+
+/* 
+ * A bounded cache of prepared public keys, keyed by the compressed point, which evicts the
+ * least recently used entry when full. Lets a caller that verifies many signatures against a
+ * few keys reuse their tables without tracking them. Not thread-safe; use one per thread.
+ */
+class PreparedPublicKeyCache final {
+	
+	private: typedef std::array<std::uint8_t,33> CompressedPoint;
+	private: typedef std::list<std::pair<CompressedPoint,PreparedPublicKey> > EntryList;
+	
+	
+	/*---- Fields ----*/
+	
+	private: std::size_t capacity;
+	private: EntryList entries;  // Most recently used first
+	private: std::map<CompressedPoint,EntryList::iterator> index;
+	private: PreparedPublicKey invalid;  // Returned for all invalid keys, which are never cached
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Constructs an empty cache holding at most the given number of keys, which must be positive.
+	public: explicit PreparedPublicKeyCache(std::size_t cap);
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Returns the prepared form of the given key, building and inserting it if absent. The returned
+	// reference remains valid until the next call to get(). An invalid key is never cached (its compressed
+	// form does not identify it), and yields a prepared key whose isValid() is false. Not constant-time.
+	public: const PreparedPublicKey &get(const PublicKey &key);
+	
+	
+	// Returns the number of keys currently cached.
+	public: std::size_t size() const;
+	
+};
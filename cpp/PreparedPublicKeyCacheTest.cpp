@@ -0,0 +1,60 @@
+/* 
+ * A runnable main program that tests the functionality of class PreparedPublicKeyCache.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "TestHelper.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include "CurvePoint.hpp"
+#include "PreparedPublicKey.hpp"
+#include "PreparedPublicKeyCache.hpp"
+#include "PublicKey.hpp"
+#include "Uint256.hpp"
+
+
+int main() {
+	int numTestCases = 0;
+	const PublicKey a(CurvePoint::privateExponentToPublicPoint(Uint256("0000000000000000000000000000000000000000000000000000000000000001")));
+	const PublicKey b(CurvePoint::privateExponentToPublicPoint(Uint256("0000000000000000000000000000000000000000000000000000000000000002")));
+	const PublicKey c(CurvePoint::privateExponentToPublicPoint(Uint256("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140")));  // Same x as a
+	PreparedPublicKeyCache cache(2);
+	
+	// Hits return the same entry, and entries hold the right keys
+	const PreparedPublicKey *pa = &cache.get(a);
+	assert(pa->getKey().getPoint() == a.getPoint());
+	assert(cache.size() == 1);
+	const PreparedPublicKey *pb = &cache.get(b);
+	assert(pb->getKey().getPoint() == b.getPoint());
+	assert(&cache.get(a) == pa);
+	assert(cache.size() == 2);
+	numTestCases++;
+	
+	// Inserting c evicts b, the least recently used one, but keeps a
+	const PreparedPublicKey *pc = &cache.get(c);
+	assert(pc->getKey().getPoint() == c.getPoint());
+	assert(cache.size() == 2);
+	assert(&cache.get(a) == pa);
+	assert(cache.get(b).getKey().getPoint() == b.getPoint());  // Rebuilt, evicting c
+	assert(&cache.get(a) == pa);
+	assert(cache.size() == 2);
+	numTestCases++;
+	
+	// Invalid keys are never cached, even if their compressed form matches a cached key
+	CurvePoint offCurve = a.getPoint();
+	offCurve.y.add(CurvePoint::FI_ONE);
+	offCurve.y.add(CurvePoint::FI_ONE);
+	assert(!cache.get(PublicKey(offCurve)).isValid());
+	assert(!cache.get(PublicKey(CurvePoint::ZERO)).isValid());
+	assert(cache.size() == 2);
+	assert(&cache.get(a) == pa);
+	numTestCases++;
+	
+	std::printf("All %d test cases passed\n", numTestCases);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+/* 
+ * A runnable main program that tests the functionality of class PreparedPublicKey.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "TestHelper.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include "CurvePoint.hpp"
+#include "PreparedPublicKey.hpp"
+#include "PublicKey.hpp"
+#include "PublicScalar.hpp"
+#include "Uint256.hpp"
+
+
+int main() {
+	int numTestCases = 0;
+	
+	// Invalid keys get no table
+	assert(!PreparedPublicKey(PublicKey(CurvePoint::ZERO)).isValid());
+	assert(PreparedPublicKey::getGenerator().isValid());
+	assert(PreparedPublicKey::getGenerator().getKey().getPoint() == CurvePoint::G);
+	numTestCases++;
+	
+	// Compare against the constant-time multiplyAdd() for every pair of scalars and various keys
+	const vector<const char *> scalars{
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"000000000000000000000000000000000000000000000000000000000000001F",
+		"0000000000000000000000000000000000000000000000000000000000000021",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+		"F800000000000000000000000000000000000000000000000000000000000000",
+		"AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA",
+		"9C43481D06F763D2D5DB07E29931A0EFAD2F0499A2482454187E1D18F4AFA9A1",
+		"0000080000041000000004000010000000001400000000000000000020200000",
+	};
+	const vector<const char *> privateKeys{
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"0000000000000000000000000000000000000000000000000000000000000002",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+		"B2160535D43F02A4FB5C13236BBDB09BFE25AAC9C4E18344C7E607FC1AD2FB16",
+	};
+	const PreparedPublicKey &gen = PreparedPublicKey::getGenerator();
+	for (const char *privKey : privateKeys) {
+		const CurvePoint point = CurvePoint::privateExponentToPublicPoint(Uint256(privKey));
+		const PreparedPublicKey key((PublicKey(point)));
+		assert(key.isValid());
+		for (const char *u1Str : scalars) {
+			for (const char *u2Str : scalars) {
+				const Uint256 u1(u1Str);
+				const Uint256 u2(u2Str);
+				CurvePoint expect = CurvePoint::multiplyAdd(u1, CurvePoint::G, u2, point);
+				CurvePoint actual = PreparedPublicKey::multiplyAddVar(PublicScalar(u1), gen, PublicScalar(u2), key);
+				expect.normalize();
+				actual.normalize();
+				assert(actual == expect);
+				numTestCases++;
+			}
+		}
+	}
+	
+	std::printf("All %d test cases passed\n", numTestCases);
+	return EXIT_SUCCESS;
+}
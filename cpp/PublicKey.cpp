@@ -0,0 +1,29 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "CountOps.hpp"
+#include "PublicKey.hpp"
+
+
+PublicKey::PublicKey(const CurvePoint &pt) :
+		point(pt),
+		valid(!pt.isZero() && pt.z == CurvePoint::FI_ONE && pt.isOnCurve()) {
+	countOps(functionOps);
+	countOps(4 * arithmeticOps);
+	countOps(1 * curvepointCopyOps);
+}
+
+
+bool PublicKey::isValid() const {
+	return valid;
+}
+
+
+const CurvePoint &PublicKey::getPoint() const {
+	return point;
+}
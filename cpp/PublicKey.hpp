@@ -0,0 +1,49 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include "CurvePoint.hpp"
+
+
+/* 
+ * A public key point that has been checked once, at construction, so that it can be used for
+ * many signature verifications without validating it again. Instances of this class are immutable.
+ * Example of usage:
+ *   PublicKey key(point);
+ *   if (!key.isValid()) { ... }
+ *   bool ok = Ecdsa::verify(key, msgHash, r, s);
+ */
+class PublicKey final {
+	
+	/*---- Fields ----*/
+	
+	private: CurvePoint point;  // Always normalized
+	private: bool valid;
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Constructs a public key from the given point and checks it: the point must be normalized, not zero,
+	// and on the curve. No check of the subgroup is needed, because the curve's cofactor is 1 (every point
+	// on the curve other than zero has order CurvePoint::ORDER). Not constant-time.
+	public: explicit PublicKey(const CurvePoint &pt);
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Tests whether the point given at construction passed all the checks.
+	public: bool isValid() const;
+	
+	
+	// Returns the point given at construction, which is meaningful only if isValid() is true.
+	public: const CurvePoint &getPoint() const;
+	
+};
@@ -0,0 +1,53 @@
+/* 
+ * A runnable main program that tests the functionality of class PublicKey.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "TestHelper.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include "CurvePoint.hpp"
+#include "PublicKey.hpp"
+
+
+int main() {
+	struct TestCase {
+		bool valid;
+		const char *x;
+		const char *y;
+	};
+	const vector<TestCase> cases{
+		{true , "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8"},
+		{true , "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "B7C52588D95C3B9AA25B0403F1EEF75702E84BB7597AABE663B82F6F04EF2777"},
+		{true , "9C33E2FB851BCC2641A4F8E9995672E28635030B110844A0A37B3C91F309CAA0", "461400EA44D24B1B0AC08ABAF69DC59D2686AD338C791D344383BA96A85097E7"},
+		{false, "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B9"},
+		{false, "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{false, "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000001"},
+	};
+	int numTestCases = 0;
+	for (const TestCase &tc : cases) {
+		const CurvePoint pt(tc.x, tc.y);
+		const PublicKey key(pt);
+		assert(key.isValid() == tc.valid);
+		assert(key.getPoint() == pt);
+		numTestCases++;
+	}
+	
+	// The zero point and points not normalized are rejected
+	assert(!PublicKey(CurvePoint::ZERO).isValid());
+	CurvePoint pt = CurvePoint::G;
+	pt.twice();
+	assert(!PublicKey(pt).isValid());
+	pt.normalize();
+	assert(PublicKey(pt).isValid());
+	numTestCases += 3;
+	
+	// Epilog
+	std::printf("All %d test cases passed\n", numTestCases);
+	return EXIT_SUCCESS;
+}
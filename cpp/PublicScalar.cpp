@@ -0,0 +1,64 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include "CountOps.hpp"
+#include "PublicScalar.hpp"
+
+using std::int8_t;
+using std::uint32_t;
+
+
+PublicScalar::PublicScalar(const Uint256 &val) :
+	value(val) {}
+
+
+PublicScalar::PublicScalar(const Scalar &val) :
+	value(val) {}
+
+
+const Uint256 &PublicScalar::getValue() const {
+	return value;
+}
+
+
+int PublicScalar::toWnaf(int width, int8_t digits[257]) const {
+	countOps(functionOps);
+	assert(2 <= width && width <= 8);
+	std::memset(digits, 0, 257 * sizeof(digits[0]));
+	int result = 0;
+	uint32_t carry = 0;
+	for (int i = 0; i < 256; ) {
+		countOps(loopBodyOps);
+		uint32_t bit = (value.value[i >> 5] >> (i & 31)) & 1;
+		countOps(4 * arithmeticOps);
+		if (bit == carry) {
+			i++;
+			continue;
+		}
+		
+		// Take the next width bits (fewer at the top), which may span two words
+		int w = 256 - i < width ? 256 - i : width;
+		uint32_t word = value.value[i >> 5] >> (i & 31);
+		if ((i & 31) + w > 32)
+			word |= value.value[(i >> 5) + 1] << (32 - (i & 31));
+		int digit = static_cast<int>((word & ((UINT32_C(1) << w) - 1)) + carry);  // Always odd
+		carry = static_cast<uint32_t>(digit >> (width - 1)) & 1;
+		digit -= static_cast<int>(carry << width);
+		digits[i] = static_cast<int8_t>(digit);
+		result = i + 1;
+		i += w;
+		countOps(16 * arithmeticOps);
+	}
+	if (carry != 0) {
+		digits[256] = 1;
+		result = 257;
+	}
+	return result;
+}
@@ -0,0 +1,54 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "Scalar.hpp"
+#include "Uint256.hpp"
+
+
+/* 
+ * An unsigned 256-bit multiplier that the caller has declared to be public, such as a signature verification
+ * coefficient. The variable-time point multiplications (CurvePoint::multiplyVar(), multiplyGeneratorVar(),
+ * multiplySumVar() and PreparedPublicKey::multiplyAddVar()) only accept this type, so that a Uint256 or Scalar
+ * holding a private key or nonce can never reach them without an explicit conversion at the call site (and finding
+ * every variable-time multiplication is a search for this class's name). Instances of this class are immutable.
+ */
+class PublicScalar final {
+	
+	/*---- Fields ----*/
+	
+	private: Uint256 value;
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Marks the given number as public. Not constant-time, in the sense that every use of the result is not.
+	public: explicit PublicScalar(const Uint256 &val);
+	
+	
+	// Marks the given number as public. Not constant-time, in the sense that every use of the result is not.
+	public: explicit PublicScalar(const Scalar &val);
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Returns the underlying number.
+	public: const Uint256 &getValue() const;
+	
+	
+	// Writes the width-w non-adjacent form of this number into digits[0 : 257] (least significant first),
+	// where every nonzero digit is odd, lies in the range (-2^(w-1), 2^(w-1)), and is followed by at least
+	// w - 1 zeros. The width must be in the range [2, 8]. Returns the number of digits up to and including
+	// the highest nonzero one (0 if this number is zero). Not constant-time.
+	public: int toWnaf(int width, std::int8_t digits[257]) const;
+	
+};
@@ -0,0 +1,116 @@
+/* 
+ * A runnable main program that tests the functionality of class PublicScalar.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "TestHelper.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include "PublicScalar.hpp"
+#include "Scalar.hpp"
+#include "Uint256.hpp"
+
+
+// Global variables
+static int numTestCases = 0;
+
+
+/*---- Test cases ----*/
+
+static void testConstructors() {
+	const Uint256 x("9C43481D06F763D2D5DB07E29931A0EFAD2F0499A2482454187E1D18F4AFA9A1");
+	assert(PublicScalar(x).getValue() == x);
+	assert(PublicScalar(Scalar(x)).getValue() == x);
+	numTestCases++;
+}
+
+
+static void testToWnafSmall() {
+	struct WnafCase {
+		int width;
+		const char *value;
+		int length;
+		std::vector<int> digits;  // Least significant first
+	};
+	const vector<WnafCase> cases{
+		{2, "0000000000000000000000000000000000000000000000000000000000000000", 0, {}},
+		{2, "0000000000000000000000000000000000000000000000000000000000000007", 4, {-1, 0, 0, 1}},
+		{3, "0000000000000000000000000000000000000000000000000000000000000007", 4, {-1, 0, 0, 1}},
+		{4, "0000000000000000000000000000000000000000000000000000000000000007", 1, {7}},
+		{4, "000000000000000000000000000000000000000000000000000000000000000B", 5, {-5, 0, 0, 0, 1}},
+		{5, "0000000000000000000000000000000000000000000000000000000000000100", 9, {0, 0, 0, 0, 0, 0, 0, 0, 1}},
+		{5, "00000000000000000000000000000000000000000000000000000000000000FF", 9, {-1, 0, 0, 0, 0, 0, 0, 0, 1}},
+		{8, "000000000000000000000000000000000000000000000000000000000000007F", 1, {127}},
+		{8, "0000000000000000000000000000000000000000000000000000000000000081", 9, {-127, 0, 0, 0, 0, 0, 0, 0, 1}},
+	};
+	for (const WnafCase &tc : cases) {
+		std::int8_t digits[257];
+		int len = PublicScalar(Uint256(tc.value)).toWnaf(tc.width, digits);
+		assert(len == tc.length);
+		for (int i = 0; i < 257; i++)
+			assert(digits[i] == (static_cast<size_t>(i) < tc.digits.size() ? tc.digits.at(i) : 0));
+		numTestCases++;
+	}
+}
+
+
+static void testToWnafProperties() {
+	const vector<const char *> cases{
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"8000000000000000000000000000000000000000000000000000000000000000",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+		"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140",
+		"7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+		"AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA",
+		"5555555555555555555555555555555555555555555555555555555555555555",
+		"00000000000000000000000000000000B2160535D43F02A4FB5C13236BBDB09B",
+		"9C43481D06F763D2D5DB07E29931A0EFAD2F0499A2482454187E1D18F4AFA9A1",
+		"0000080000041000000004000010000000001400000000000000000020200000",
+		"BFEFFFFFFFFFFFFFFFEFFFFFBFFFFFEFFFFAFFFFFBFFFFFFFFFFFFFFFFFFFFFF",
+		"F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0F0",
+	};
+	for (const char *str : cases) {
+		const Uint256 value(str);
+		for (int width = 2; width <= 8; width++) {
+			std::int8_t digits[257];
+			int len = PublicScalar(value).toWnaf(width, digits);
+			assert(0 < len && len <= 257 && digits[len - 1] != 0);
+			
+			// Check the digit constraints, and evaluate the digits modulo 2^256 from the most significant one
+			Uint256 sum(Uint256::ZERO);
+			int lastNonzero = 1000;
+			for (int i = 256; i >= 0; i--) {
+				sum.shiftLeft1();
+				int d = digits[i];
+				if (d == 0)
+					continue;
+				assert(i < len);
+				assert((d & 1) != 0 && -(1 << (width - 1)) < d && d < (1 << (width - 1)));
+				assert(lastNonzero - i >= width);
+				lastNonzero = i;
+				Uint256 mag(Uint256::ZERO);
+				mag.value[0] = static_cast<std::uint32_t>(d > 0 ? d : -d);
+				if (d > 0)
+					sum.add(mag);
+				else
+					sum.subtract(mag);
+			}
+			assert(sum == value);
+			numTestCases++;
+		}
+	}
+}
+
+
+int main() {
+	testConstructors();
+	testToWnafSmall();
+	testToWnafProperties();
+	std::printf("All %d test cases passed\n", numTestCases);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include "CurvePoint.hpp"
+#include "Rfc6979.hpp"
+
+using std::uint8_t;
+using std::uint32_t;
+using std::size_t;
+
+
+Rfc6979::Rfc6979(const Uint256 &privateKey, const Sha256Hash &msgHash) :
+		hasOutput(false) {
+	uint8_t seed[64];
+	getSeed(privateKey, msgHash, seed);
+	initialize(seed, sizeof(seed));
+}
+
+
+Rfc6979::Rfc6979(const Uint256 &privateKey, const Sha256Hash &msgHash, const uint8_t extraEntropy[EXTRA_ENTROPY_LEN]) :
+		hasOutput(false) {
+	assert(extraEntropy != nullptr);
+	uint8_t seed[64 + EXTRA_ENTROPY_LEN];
+	getSeed(privateKey, msgHash, seed);
+	std::memcpy(&seed[64], extraEntropy, EXTRA_ENTROPY_LEN);
+	initialize(seed, sizeof(seed));
+}
+
+
+Uint256 Rfc6979::next() {
+	/* 
+	 * Algorithm pseudocode (RFC 6979 section 3.2, steps h.3 and h.2):
+	 * loop:
+	 *   if (a nonce was returned or rejected before)
+	 *     K = HMAC_K(V || 0x00), V = HMAC_K(V)
+	 *   V = HMAC_K(V)
+	 *   k = V as a big-endian integer
+	 *   if (k in range [1, order-1]) return k
+	 */
+	while (true) {
+		if (hasOutput)
+			update(0x00, nullptr, 0);
+		hasOutput = true;
+		Sha256 inner = innerHasher;
+		inner.append(v, sizeof(v));
+		const Sha256Hash newV = finishHmac(inner);
+		std::memcpy(v, newV.value, sizeof(v));
+		const Uint256 k(v);
+		if (k != Uint256::ZERO && k < CurvePoint::ORDER)
+			return k;
+	}
+}
+
+
+void Rfc6979::update(uint8_t sep, const uint8_t seed[], size_t seedLen) {
+	Sha256 inner = innerHasher;
+	inner.append(v, sizeof(v)).append(&sep, 1).append(seed, seedLen);
+	const Sha256Hash newK = finishHmac(inner);
+	setKey(newK.value);
+	inner = innerHasher;
+	inner.append(v, sizeof(v));
+	const Sha256Hash newV = finishHmac(inner);
+	std::memcpy(v, newV.value, sizeof(v));
+}
+
+
+void Rfc6979::setKey(const uint8_t key[Sha256Hash::HASH_LEN]) {
+	// The key is shorter than a block, so it is zero-padded to one block and each hasher holds only a midstate
+	uint8_t block[Sha256::BLOCK_LEN] = {};
+	std::memcpy(block, key, Sha256Hash::HASH_LEN);
+	for (int i = 0; i < Sha256::BLOCK_LEN; i++)
+		block[i] ^= 0x36;
+	innerHasher = Sha256();
+	innerHasher.append(block, sizeof(block));
+	for (int i = 0; i < Sha256::BLOCK_LEN; i++)
+		block[i] ^= 0x36 ^ 0x5C;
+	outerHasher = Sha256();
+	outerHasher.append(block, sizeof(block));
+}
+
+
+Sha256Hash Rfc6979::finishHmac(Sha256 &inner) const {
+	const Sha256Hash innerHash = inner.getHash();
+	Sha256 outer = outerHasher;
+	return outer.append(innerHash.value, Sha256Hash::HASH_LEN).getHash();
+}
+
+
+void Rfc6979::initialize(const uint8_t seed[], size_t seedLen) {
+	// RFC 6979 section 3.2, steps b to g
+	const uint8_t zeroKey[Sha256Hash::HASH_LEN] = {};
+	setKey(zeroKey);
+	std::memset(v, 0x01, sizeof(v));
+	update(0x00, seed, seedLen);
+	update(0x01, seed, seedLen);
+}
+
+
+void Rfc6979::getSeed(const Uint256 &privateKey, const Sha256Hash &msgHash, uint8_t seed[64]) {
+	assert(privateKey != Uint256::ZERO && privateKey < CurvePoint::ORDER);
+	privateKey.getBigEndianBytes(&seed[0]);
+	Uint256 h(msgHash.value);
+	h.subtract(CurvePoint::ORDER, static_cast<uint32_t>(h >= CurvePoint::ORDER));
+	h.getBigEndianBytes(&seed[32]);
+}
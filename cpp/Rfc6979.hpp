@@ -0,0 +1,78 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+
+/* 
+ * Generates deterministic ECDSA nonces for secp256k1 as specified in RFC 6979, using HMAC-DRBG with SHA-256.
+ * The nonces are the same as those of other RFC 6979 signers (e.g. libsecp256k1), including when 32 bytes
+ * of extra entropy are appended to the seed (RFC 6979 section 3.6). Each instance is a stateful generator;
+ * every HMAC reuses the SHA-256 states after the ipad and opad key blocks instead of rehashing the key.
+ */
+class Rfc6979 final {
+	
+	/*---- Public constants ----*/
+	
+	public: static constexpr int EXTRA_ENTROPY_LEN = 32;  // In bytes
+	
+	
+	
+	/*---- Instance members ----*/
+	
+	private: Sha256 innerHasher;  // Has absorbed exactly the block (key XOR ipad) for the current key K
+	private: Sha256 outerHasher;  // Has absorbed exactly the block (key XOR opad) for the current key K
+	private: std::uint8_t v[Sha256Hash::HASH_LEN];
+	private: bool hasOutput;
+	
+	
+	// Constructs a generator seeded with the given private key, which must be in the range [1, CurvePoint::ORDER),
+	// and message hash (which is reduced modulo the order). Constant-time with respect to both values.
+	public: explicit Rfc6979(const Uint256 &privateKey, const Sha256Hash &msgHash);
+	
+	
+	// Constructs a generator like the other constructor, but with the given extra entropy appended to the seed.
+	// Constant-time with respect to all values.
+	public: explicit Rfc6979(const Uint256 &privateKey, const Sha256Hash &msgHash,
+		const std::uint8_t extraEntropy[EXTRA_ENTROPY_LEN]);
+	
+	
+	// Returns the next nonce, which is in the range [1, CurvePoint::ORDER). The first call gives the RFC 6979 nonce;
+	// later calls continue the DRBG, for when a signature with the previous nonce fails. Constant-time with respect
+	// to the seed, except that the vanishingly rare out-of-range candidates take extra time.
+	public: Uint256 next();
+	
+	
+	// Computes K = HMAC_K(V || sep || seed) and then V = HMAC_K(V). Constant-time with respect to all values.
+	private: void update(std::uint8_t sep, const std::uint8_t seed[], std::size_t seedLen);
+	
+	
+	// Sets innerHasher and outerHasher for the given 32-byte HMAC key. Constant-time with respect to the value.
+	private: void setKey(const std::uint8_t key[Sha256Hash::HASH_LEN]);
+	
+	
+	// Returns HMAC_K(message), given a copy of innerHasher that has absorbed the message.
+	private: Sha256Hash finishHmac(Sha256 &inner) const;
+	
+	
+	private: void initialize(const std::uint8_t seed[], std::size_t seedLen);
+	
+	
+	
+	/*---- Static functions ----*/
+	
+	// Writes privateKey || (msgHash mod CurvePoint::ORDER) as 64 big-endian bytes. Constant-time with respect to both values.
+	private: static void getSeed(const Uint256 &privateKey, const Sha256Hash &msgHash, std::uint8_t seed[64]);
+	
+};
@@ -0,0 +1,118 @@
+/* 
+ * A runnable main program that measures and prints the cost of deterministic nonce generation
+ * per signature: the single HMAC of signWithHmacNonce(), RFC 6979 computed with plain
+ * Sha256::getHmac() calls, and class Rfc6979 with its cached HMAC midstates.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "CurvePoint.hpp"
+#include "Ecdsa.hpp"
+#include "Rfc6979.hpp"
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+using std::uint8_t;
+
+
+static const int TRIALS = 3;
+
+static volatile std::uint32_t sink;  // Keeps the compiler from discarding the results
+
+
+// Returns the fastest of a few trials of the given operation, in nanoseconds per call.
+template <typename Func>
+static double benchmark(long iterations, Func func) {
+	double best = -1;
+	for (int i = 0; i < TRIALS; i++) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (long j = 0; j < iterations; j++)
+			func();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		double time = elapsed.count() / iterations;
+		if (best < 0 || time < best)
+			best = time;
+	}
+	return best;
+}
+
+
+static void print(const char *name, double nanos) {
+	std::printf("%10.2f us  %9.0f /s  %s\n", nanos / 1000, 1e9 / nanos, name);
+}
+
+
+// The first RFC 6979 nonce, with every HMAC rehashing the padded key. For comparison only.
+static Uint256 plainRfc6979Nonce(const Uint256 &privateKey, const Sha256Hash &msgHash) {
+	uint8_t k[32] = {};
+	uint8_t v[32];
+	std::memset(v, 0x01, sizeof(v));
+	uint8_t buf[32 + 1 + 64];
+	privateKey.getBigEndianBytes(&buf[33]);
+	Uint256 h(msgHash.value);
+	h.subtract(CurvePoint::ORDER, static_cast<std::uint32_t>(h >= CurvePoint::ORDER));
+	h.getBigEndianBytes(&buf[65]);
+	for (uint8_t sep = 0; sep < 2; sep++) {
+		std::memcpy(buf, v, sizeof(v));
+		buf[32] = sep;
+		std::memcpy(k, Sha256::getHmac(k, sizeof(k), buf, sizeof(buf)).value, sizeof(k));
+		std::memcpy(v, Sha256::getHmac(k, sizeof(k), v, sizeof(v)).value, sizeof(v));
+	}
+	while (true) {
+		std::memcpy(v, Sha256::getHmac(k, sizeof(k), v, sizeof(v)).value, sizeof(v));
+		const Uint256 result(v);
+		if (result != Uint256::ZERO && result < CurvePoint::ORDER)
+			return result;
+		std::memcpy(buf, v, sizeof(v));
+		buf[32] = 0x00;
+		std::memcpy(k, Sha256::getHmac(k, sizeof(k), buf, 33).value, sizeof(k));
+		std::memcpy(v, Sha256::getHmac(k, sizeof(k), v, sizeof(v)).value, sizeof(v));
+	}
+}
+
+
+int main() {
+	Uint256 privateKey("8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8");
+	const Sha256Hash msgHash = Sha256::getHash(nullptr, 0);
+	const uint8_t extraEntropy[Rfc6979::EXTRA_ENTROPY_LEN] = {};
+	if (plainRfc6979Nonce(privateKey, msgHash) != Rfc6979(privateKey, msgHash).next()) {
+		std::printf("Nonce mismatch\n");
+		return EXIT_FAILURE;
+	}
+	
+	print("HMAC nonce (signWithHmacNonce)", benchmark(100000, [&]() {
+		uint8_t keyBytes[32];
+		privateKey.getBigEndianBytes(keyBytes);
+		const Sha256Hash hmac = Sha256::getHmac(keyBytes, sizeof(keyBytes), msgHash.value, Sha256Hash::HASH_LEN);
+		privateKey.value[1] ^= hmac.value[0];  // Vary the key between calls
+	}));
+	print("RFC 6979 nonce, Sha256::getHmac per step", benchmark(100000, [&]() {
+		const Uint256 k = plainRfc6979Nonce(privateKey, msgHash);
+		privateKey.value[1] ^= k.value[0];
+	}));
+	print("RFC 6979 nonce, Rfc6979 (cached midstates)", benchmark(100000, [&]() {
+		const Uint256 k = Rfc6979(privateKey, msgHash).next();
+		privateKey.value[1] ^= k.value[0];
+	}));
+	print("RFC 6979 nonce with extra entropy, Rfc6979", benchmark(100000, [&]() {
+		const Uint256 k = Rfc6979(privateKey, msgHash, extraEntropy).next();
+		privateKey.value[1] ^= k.value[0];
+	}));
+	Uint256 r, s;
+	print("Ecdsa::signWithRfc6979Nonce (whole signature)", benchmark(1000, [&]() {
+		Ecdsa::signWithRfc6979Nonce(privateKey, msgHash, r, s);
+		privateKey.value[1] ^= s.value[0];
+	}));
+	sink = privateKey.value[1];
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+/* 
+ * A runnable main program that tests the functionality of class Rfc6979.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "TestHelper.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "Rfc6979.hpp"
+#include "Sha256.hpp"
+#include "Sha256Hash.hpp"
+#include "Uint256.hpp"
+
+
+// Global variables
+static int numTestCases = 0;
+
+
+/*---- Test cases ----*/
+
+static void testNonces() {
+	struct NonceCase {
+		const char *privateKey;
+		const char *message;  // ASCII, hashed with SHA-256
+		const char *extraEntropy;  // Empty for none
+		vector<const char *> expectedNonces;  // First few outputs of the DRBG
+	};
+	const vector<NonceCase> cases{
+		// Widely published secp256k1 RFC 6979 nonces (first output)
+		{"0000000000000000000000000000000000000000000000000000000000000001", "Satoshi Nakamoto", "", {"8F8A276C19F4149656B280621E358CCE24F5F52542772691EE69063B74F15D15", "F15FB763A6BCBBACBDE0A6A9AE2A02482BD92F3E75A50B357BD551DDD771045E", "872B0D837884B32FAFBCC50E31A1D92FF5EC12C2DB539D36B0A7E69C24EF9999"}},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "All those moments will be lost in time, like tears in rain. Time to die...", "", {"38AA22D72376B4DBC472E06C3BA403EE0A394DA63FC58D88686C611ABA98D6B3", "DC5417A2ADA98871B9EE7DB9E12E62E7283F6FC0E18A1C1B161E7E75A64034BA", "66F8236C5CBCEAECB8880E1C9B4AB748242E07D4ED7049AF64F9D4130510F05E"}},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "Satoshi Nakamoto", "", {"33A19B60E25FB6F4435AF53A3D42D493644827367E6453928554F43E49AA6F90", "635653806D2B851EDB5EB4A3E0098AD6DF9CF16447DC19530C33854E78A5C964", "331B9715FE5B0E397B80C9915744FA59C08A6FCBC5ED55E44E72321F320AED92"}},
+		{"F8B8AF8CE3C7CCA5E300D33939540C10D45CE001B8F252BFBC57BA0342904181", "Alan Turing", "", {"525A82B70E67874398067543FD84C83D30C175FDC45FDEEE082FE13B1D7CFDF1", "7FD11AA3DB66AD20C832D3DF288D33982ACA50B1CD436880B44D839819087A84", "1F8369104D199F4BEE612FFCAEAB185BA63FBBCBD9AA33E6B9C9D4CD224C48BB"}},
+		{"E91671C46231F833A6406CCBEA0E3E392C76C167BAC1CB013F6F1013980455C2", "There is a computer disease that anybody who works with computers knows about. It's a very serious disease and it interferes completely with the work. The trouble with computers is that you 'play' with them!", "", {"1F4B84C23A86A221D233F2521BE018D9318639D5B8BBD6374A8A59232D16AD3D", "612AEDE6745CF5DD1CCB89DA21665A8A7CFDF086CF724654A095701EB5C6C4AF", "244B77F65C30FCCA63D217F4E2219ACE2864F138D26E8D3934669347BF4816B8"}},
+		// With extra entropy
+		{"0000000000000000000000000000000000000000000000000000000000000001", "Satoshi Nakamoto", "0000000000000000000000000000000000000000000000000000000000000000", {"C2D46CF83BD97A7F7F56EE7CB455EE32144BBE55CCD6A396841CF8FAD25C4EDF", "B91B63DAFEE30A943153E124C78ADCEE0BB3EF5C0AF19C9BCDE2DB50C7DDB674", "DC7E38BF1379770F673A3D3FF4D3204D888A6F3ED5ECD3D28165E13880604D6C"}},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "Satoshi Nakamoto", "0000000000000000000000000000000000000000000000000000000000000001", {"DBA9A88A555F1D818BB6800D214A08C034E823BD41FDC86E6D85947FAA189C55", "918930B3D7ACD148CDAFF3F72E3BB947787EFE06F8D9667C4FFB796D776CB520", "AE6F6060464E54405D2B1A4126E70B316F8B9697F07B1E053313ED01E99002C4"}},
+		{"8B46893E711C8948B28E7637BFBED61666E0118ED4D361BED1F18058214C69B8", "", "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F", {"A2C86685359AB9850F9596BFD758C5DE7EFA616C4FBA7D26D508271B616F9B7C", "3E8AAFAE7035346C3E66710E76C8F3E3B887746456374BA965C77823F7902DAF", "B3CC959C9E87CB04259D01A7705D9DBA8141B83DB804F21D033804A430449ABF"}},
+	};
+	for (const NonceCase &tc : cases) {
+		const Bytes msg = asciiBytes(tc.message);
+		const Sha256Hash msgHash = Sha256::getHash(msg.data(), msg.size());
+		const Bytes extra = hexBytes(tc.extraEntropy);
+		Rfc6979 gen = extra.empty() ? Rfc6979(Uint256(tc.privateKey), msgHash) : Rfc6979(Uint256(tc.privateKey), msgHash, extra.data());
+		for (const char *expected : tc.expectedNonces) {
+			assert(gen.next() == Uint256(expected));
+			numTestCases++;
+		}
+	}
+}
+
+
+static void testMessageHashReduction() {
+	// A message hash at least the order is reduced before seeding, as bits2octets() requires
+	const Uint256 privateKey = Uint256::ONE;
+	Rfc6979 gen(privateKey, Sha256Hash("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"));
+	assert(gen.next() == Uint256("71139AAC71B52F7D5961915AF1B30F94BAF35E39B0043C33D41A57D476A8905C"));
+	numTestCases++;
+}
+
+
+/*---- Main runner ----*/
+
+int main() {
+	testNonces();
+	testMessageHashReduction();
+	std::printf("All %d test cases passed\n", numTestCases);
+	return EXIT_SUCCESS;
+}
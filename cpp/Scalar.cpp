@@ -0,0 +1,318 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include "CountOps.hpp"
+#include "Scalar.hpp"
+
+using std::uint32_t;
+using std::uint64_t;
+
+
+Scalar::Scalar(const char *str) :
+		Uint256(str) {
+	// See the comment in the FieldInt string constructor about the order of static initialization
+	if (MODULUS.value[0] != 0)
+		assert(Uint256::operator<(MODULUS));
+}
+
+
+Scalar::Scalar(const Uint256 &val) :
+		Uint256(val) {
+	Uint256::subtract(MODULUS, static_cast<uint32_t>(Uint256::operator>=(MODULUS)));
+	assert(Uint256::operator<(MODULUS));
+}
+
+
+void Scalar::add(const Scalar &other) {
+	countOps(functionOps);
+	uint32_t c = Uint256::add(other);  // Perform addition
+	assert((c >> 1) == 0);
+	Uint256::subtract(MODULUS, c | static_cast<uint32_t>(Uint256::operator>=(MODULUS)));  // Conditionally subtract modulus
+	countOps(1 * arithmeticOps);
+}
+
+
+void Scalar::subtract(const Scalar &other) {
+	countOps(functionOps);
+	uint32_t b = Uint256::subtract(other);  // Perform subtraction
+	assert((b >> 1) == 0);
+	Uint256::add(MODULUS, b);  // Conditionally add modulus
+}
+
+
+void Scalar::negate() {
+	countOps(functionOps);
+	Uint256 temp = MODULUS;
+	temp.subtract(*this);
+	Uint256::replace(temp, static_cast<uint32_t>(Uint256::operator!=(ZERO)));
+	countOps(1 * uint256CopyOps);
+}
+
+
+void Scalar::multiply(const Scalar &other) {
+	countOps(functionOps);
+	
+	uint32_t product[NUM_WORDS * 2];
+	multiplyFull(*this, other, product);
+	
+	// Because 2^256 = 2^256 - MODULUS (mod MODULUS), which is only 129 bits long, the high words can be
+	// folded into the low words. Each fold shrinks the excess above 2^256: from 256 bits to 130, then 4, then 1.
+	uint32_t temp0[NUM_WORDS + 6];  // Less than 2^386
+	fold(&product[0], &product[NUM_WORDS], NUM_WORDS, temp0);
+	uint32_t temp1[NUM_WORDS + 6];  // Less than 2^260
+	fold(&temp0[0], &temp0[NUM_WORDS], 5, temp1);
+	uint32_t temp2[NUM_WORDS + 6];  // Less than 2^256 + 2^133
+	fold(&temp1[0], &temp1[NUM_WORDS], 1, temp2);
+	assert(temp2[NUM_WORDS] <= 1);
+	
+	// Final conditional subtraction to yield a Scalar value. If temp2 >= 2^256, then
+	// temp2 - MODULUS < 2^133 + 2^129, so the subtraction wrapping around modulo 2^256 is harmless.
+	std::memcpy(this->value, temp2, sizeof(value));
+	countOps(functionOps);
+	countOps(NUM_WORDS * arithmeticOps);
+	uint32_t dosub = static_cast<uint32_t>((temp2[NUM_WORDS] != 0) | Uint256::operator>=(MODULUS));
+	Uint256::subtract(MODULUS, dosub);
+	countOps(2 * arithmeticOps);
+}
+
+
+void Scalar::reciprocal() {
+	countOps(functionOps);
+	Uint256::reciprocal(MODULUS);
+}
+
+
+void Scalar::reciprocalVar() {
+	countOps(functionOps);
+	Uint256::reciprocalVar(MODULUS);
+}
+
+
+void Scalar::reciprocalBatch(Scalar vals[], std::size_t len, Scalar scratch[]) {
+	/* 
+	 * Montgomery's trick: with scratch[i] = v[0] * ... * v[i] (using 1 in place of zero values), invert only
+	 * scratch[len-1], then walk backward: 1/v[i] = 1/scratch[i] * scratch[i-1], and 1/scratch[i-1] = 1/scratch[i] * v[i].
+	 */
+	countOps(functionOps);
+	if (len == 0)
+		return;
+	const Scalar zero(Uint256::ZERO);
+	const Scalar one(Uint256::ONE);
+	Scalar acc = one;
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		Scalar v = vals[i];
+		v.replace(one, static_cast<uint32_t>(v == zero));
+		acc.multiply(v);
+		scratch[i] = acc;
+		countOps(2 * uint256CopyOps);
+	}
+	acc.reciprocal();
+	for (std::size_t i = len; i-- > 0; ) {
+		countOps(loopBodyOps);
+		Scalar v = vals[i];
+		uint32_t isZero = static_cast<uint32_t>(v == zero);
+		v.replace(one, isZero);
+		Scalar inv = acc;
+		if (i > 0)  // Depends only on the public loop index
+			inv.multiply(scratch[i - 1]);
+		acc.multiply(v);
+		inv.replace(zero, isZero);
+		vals[i] = inv;
+		countOps(3 * uint256CopyOps);
+	}
+}
+
+
+void Scalar::reciprocalBatchVar(Scalar vals[], std::size_t len, Scalar scratch[]) {
+	// Same algorithm as reciprocalBatch(), but zero values are skipped by branching
+	countOps(functionOps);
+	const Scalar zero(Uint256::ZERO);
+	Scalar acc(Uint256::ONE);
+	for (std::size_t i = 0; i < len; i++) {
+		countOps(loopBodyOps);
+		if (vals[i] != zero)
+			acc.multiply(vals[i]);
+		scratch[i] = acc;
+		countOps(1 * uint256CopyOps);
+	}
+	acc.reciprocalVar();
+	for (std::size_t i = len; i-- > 0; ) {
+		countOps(loopBodyOps);
+		if (vals[i] == zero)
+			continue;
+		Scalar inv = acc;
+		if (i > 0)
+			inv.multiply(scratch[i - 1]);
+		acc.multiply(vals[i]);
+		vals[i] = inv;
+		countOps(2 * uint256CopyOps);
+	}
+}
+
+
+void Scalar::replace(const Scalar &other, uint32_t enable) {
+	countOps(functionOps);
+	Uint256::replace(other, enable);
+}
+
+
+bool Scalar::operator==(const Scalar &other) const {
+	countOps(functionOps);
+	return Uint256::operator==(other);
+}
+
+bool Scalar::operator!=(const Scalar &other) const {
+	countOps(functionOps);
+	return Uint256::operator!=(other);
+}
+
+bool Scalar::operator<(const Scalar &other) const {
+	countOps(functionOps);
+	return Uint256::operator<(other);
+}
+
+bool Scalar::operator<=(const Scalar &other) const {
+	countOps(functionOps);
+	return Uint256::operator<=(other);
+}
+
+bool Scalar::operator>(const Scalar &other) const {
+	countOps(functionOps);
+	return Uint256::operator>(other);
+}
+
+bool Scalar::operator>=(const Scalar &other) const {
+	countOps(functionOps);
+	return Uint256::operator>=(other);
+}
+
+
+void Scalar::splitLambda(const Scalar &k, Scalar &r1, Scalar &r2) {
+	/* 
+	 * Algorithm pseudocode (Babai rounding against a reduced basis of the lattice {(a, b) : a + b * lambda = 0 mod order}):
+	 * c1 = round(k * b2 / order)
+	 * c2 = round(k * (-b1) / order)
+	 * r2 = c1 * (-b1) + c2 * (-b2)
+	 * r1 = k - r2 * lambda
+	 */
+	countOps(functionOps);
+	Scalar c1 = multiplyShift384(k, G1);
+	Scalar c2 = multiplyShift384(k, G2);
+	c1.multiply(MINUS_B1);
+	c2.multiply(MINUS_B2);
+	r2 = c1;
+	r2.add(c2);
+	r1 = r2;
+	r1.multiply(LAMBDA);
+	r1.negate();
+	r1.add(k);
+	countOps(2 * uint256CopyOps);
+}
+
+
+void Scalar::splitLambdaVar(const Scalar &k, Scalar &r1, Scalar &r2) {
+	countOps(functionOps);
+	if ((k.value[4] | k.value[5] | k.value[6] | k.value[7]) == 0) {
+		r1 = k;
+		r2 = Scalar(Uint256::ZERO);
+		countOps(2 * uint256CopyOps);
+	} else
+		splitLambda(k, r1, r2);
+}
+
+
+void Scalar::multiplyFull(const Uint256 &x, const Uint256 &y, uint32_t out[NUM_WORDS * 2]) {
+	// Compute raw product of (uint256 x) * (uint256 y) = (uint512 out), via long multiplication
+	countOps(functionOps);
+	std::memset(out, 0, NUM_WORDS * 2 * sizeof(out[0]));
+	countOps(NUM_WORDS * 2 * arithmeticOps);
+	for (int i = 0; i < NUM_WORDS; i++) {
+		countOps(loopBodyOps);
+		uint32_t carry = 0;
+		countOps(1 * arithmeticOps);
+		for (int j = 0; j < NUM_WORDS; j++) {
+			countOps(loopBodyOps);
+			uint64_t sum = static_cast<uint64_t>(x.value[i]) * y.value[j];
+			sum += static_cast<uint64_t>(out[i + j]) + carry;  // Does not overflow
+			out[i + j] = static_cast<uint32_t>(sum);
+			carry = static_cast<uint32_t>(sum >> 32);
+			countOps(11 * arithmeticOps);
+		}
+		out[i + NUM_WORDS] = carry;
+		countOps(1 * arithmeticOps);
+	}
+}
+
+
+Scalar Scalar::multiplyShift384(const Scalar &k, const Uint256 &g) {
+	countOps(functionOps);
+	uint32_t product[NUM_WORDS * 2];
+	multiplyFull(k, g, product);
+	Uint256 result(Uint256::ZERO);
+	std::memcpy(result.value, &product[12], 4 * sizeof(product[0]));
+	Uint256 round(Uint256::ZERO);
+	round.value[0] = product[11] >> 31;  // Bit 383
+	result.add(round);
+	countOps(4 * arithmeticOps);
+	countOps(2 * uint256CopyOps);
+	return Scalar(result);
+}
+
+
+void Scalar::fold(const uint32_t lo[], const uint32_t hi[], int hiLen, uint32_t out[]) {
+	countOps(functionOps);
+	assert(0 < hiLen && hiLen <= NUM_WORDS);
+	std::memset(out, 0, (NUM_WORDS + 6) * sizeof(out[0]));
+	countOps((NUM_WORDS + 6) * arithmeticOps);
+	
+	// Compute hi * COMPLEMENT via long multiplication
+	for (int i = 0; i < hiLen; i++) {
+		countOps(loopBodyOps);
+		uint32_t carry = 0;
+		countOps(1 * arithmeticOps);
+		for (int j = 0; j < COMPLEMENT_WORDS; j++) {
+			countOps(loopBodyOps);
+			uint64_t sum = static_cast<uint64_t>(hi[i]) * COMPLEMENT[j];
+			sum += static_cast<uint64_t>(out[i + j]) + carry;  // Does not overflow
+			out[i + j] = static_cast<uint32_t>(sum);
+			carry = static_cast<uint32_t>(sum >> 32);
+			countOps(11 * arithmeticOps);
+		}
+		out[i + COMPLEMENT_WORDS] = carry;
+		countOps(1 * arithmeticOps);
+	}
+	
+	// Add lo
+	uint32_t carry = 0;
+	countOps(1 * arithmeticOps);
+	for (int i = 0; i < NUM_WORDS + 6; i++) {
+		countOps(loopBodyOps);
+		uint64_t sum = static_cast<uint64_t>(out[i]) + carry;
+		if (i < NUM_WORDS)
+			sum += lo[i];
+		out[i] = static_cast<uint32_t>(sum);
+		carry = static_cast<uint32_t>(sum >> 32);
+		countOps(8 * arithmeticOps);
+	}
+	assert(carry == 0);
+}
+
+
+// Static initializers
+const Uint256 Scalar::MODULUS("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
+const uint32_t Scalar::COMPLEMENT[COMPLEMENT_WORDS] = {
+	UINT32_C(0x2FC9BEBF), UINT32_C(0x402DA173), UINT32_C(0x50B75FC4), UINT32_C(0x45512319), UINT32_C(0x00000001),
+};
+const Scalar Scalar::LAMBDA  ("5363AD4CC05C30E0A5261C028812645A122E22EA20816678DF02967C1B23BD72");
+const Scalar Scalar::MINUS_B1("00000000000000000000000000000000E4437ED6010E88286F547FA90ABFE4C3");
+const Scalar Scalar::MINUS_B2("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE8A280AC50774346DD765CDA83DB1562C");
+const Uint256 Scalar::G1     ("3086D221A7D46BCDE86C90E49284EB153DAA8A1471E8CA7FE893209A45DBB031");
+const Uint256 Scalar::G2     ("E4437ED6010E88286F547FA90ABFE4C4221208AC9DF506C61571B4AE8AC47F71");
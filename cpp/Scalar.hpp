@@ -0,0 +1,154 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Uint256.hpp"
+
+
+/* 
+ * An unsigned 256-bit integer modulo the order of the secp256k1 base point, which is a prime number
+ * (CurvePoint::ORDER). This is the counterpart of FieldInt for private keys, nonces and signature values.
+ * Provides simple arithmetic operations (+, -, *, 1/). Some methods have the same name and signature
+ * as Uint256, and the number representation format is the same as Uint256. It is illegal to set the
+ * value to be greater than or equal to MODULUS; undefined behavior will result. Instances of this class are mutable.
+ */
+class Scalar final : private Uint256 {
+	
+	public: using Uint256::NUM_WORDS;
+	
+	/*---- Fields ----*/
+	
+	public: using Uint256::value;
+	
+	
+	
+	/*---- Constructors ----*/
+	
+	// Constructs a Scalar from the given 64-character hexadecimal string. Not constant-time.
+	// If the syntax of the string is invalid, then an assertion will fail.
+	public: explicit Scalar(const char *str);
+	
+	
+	// Constructs a Scalar from the given Uint256, reducing it modulo the order (a single
+	// conditional subtraction suffices because 2^256 < 2 * MODULUS). Constant-time with respect to the given value.
+	public: explicit Scalar(const Uint256 &val);
+	
+	
+	
+	/*---- Arithmetic methods ----*/
+	
+	// Adds the given number into this number, modulo the order. Constant-time with respect to both values.
+	public: void add(const Scalar &other);
+	
+	
+	// Subtracts the given number from this number, modulo the order. Constant-time with respect to both values.
+	public: void subtract(const Scalar &other);
+	
+	
+	// Negates this number, modulo the order. Zero stays zero. Constant-time with respect to this value.
+	public: void negate();
+	
+	
+	// Multiplies the given number into this number, modulo the order. Constant-time with respect to both values.
+	public: void multiply(const Scalar &other);
+	
+	
+	// Computes the multiplicative inverse of this number with respect to the order.
+	// If this number is zero, the reciprocal is zero. Constant-time with respect to this value.
+	public: void reciprocal();
+	
+	
+	// Computes the multiplicative inverse of this number with respect to the order.
+	// If this number is zero, the reciprocal is zero. Not constant-time; only use it on public values.
+	public: void reciprocalVar();
+	
+	
+	// Replaces each of the given numbers with its multiplicative inverse with respect to the order, with the same
+	// results as calling reciprocal() on each one (zero stays zero), but using a single inversion and 3 multiplications
+	// per number (Montgomery's trick). The scratch array must have room for len numbers; its contents on return
+	// are unspecified. Constant-time with respect to the values, but not the length.
+	public: static void reciprocalBatch(Scalar vals[], std::size_t len, Scalar scratch[]);
+	
+	
+	// Replaces each of the given numbers with its multiplicative inverse, with the same results and scratch
+	// requirement as reciprocalBatch(). Zero values are skipped. Not constant-time; only use it on public values.
+	public: static void reciprocalBatchVar(Scalar vals[], std::size_t len, Scalar scratch[]);
+	
+	
+	/*---- Miscellaneous methods ----*/
+	
+	public: void replace(const Scalar &other, std::uint32_t enable);
+	
+	public: using Uint256::getBigEndianBytes;
+	
+	
+	/*---- Equality and inequality operators ----*/
+	
+	public: bool operator==(const Scalar &other) const;
+	
+	public: bool operator!=(const Scalar &other) const;
+	
+	public: bool operator<(const Scalar &other) const;
+	
+	public: bool operator<=(const Scalar &other) const;
+	
+	public: bool operator>(const Scalar &other) const;
+	
+	public: bool operator>=(const Scalar &other) const;
+	
+	
+	
+	/*---- Static functions ----*/
+	
+	// Splits k into r1 and r2 such that r1 + r2 * LAMBDA = k (mod order), where each of r1 and r2
+	// is short when viewed as a signed number: either less than 2^128 or greater than order - 2^128.
+	// This is the GLV decomposition with the lattice basis from libsecp256k1. Constant-time with respect to the value.
+	public: static void splitLambda(const Scalar &k, Scalar &r1, Scalar &r2);
+	
+	
+	// Splits k with the same contract as splitLambda(), except that when k is already less than
+	// 2^128 (such as a batch verification weight) it returns r1 = k and r2 = 0. Not constant-time.
+	public: static void splitLambdaVar(const Scalar &k, Scalar &r1, Scalar &r2);
+	
+	
+	
+	/*---- Helper functions ----*/
+	
+	// Computes the raw 512-bit product of the two numbers. Constant-time with respect to both values.
+	private: static void multiplyFull(const Uint256 &x, const Uint256 &y, std::uint32_t out[NUM_WORDS * 2]);
+	
+	
+	// Returns round(k * g / 2^384), which is less than 2^128 for the constants used here.
+	// Constant-time with respect to both values.
+	private: static Scalar multiplyShift384(const Scalar &k, const Uint256 &g);
+	
+	
+	// Computes out = lo + hi * (2^256 - MODULUS), where lo has NUM_WORDS words and hi has hiLen words (at most NUM_WORDS).
+	// The output has NUM_WORDS + 6 words, which is always enough. Constant-time with respect to the values.
+	private: static void fold(const std::uint32_t lo[], const std::uint32_t hi[], int hiLen, std::uint32_t out[]);
+	
+	
+	
+	/*---- Class constants ----*/
+	
+	private: static const Uint256 MODULUS;  // Prime number, equal to CurvePoint::ORDER
+	
+	private: static constexpr int COMPLEMENT_WORDS = 5;
+	private: static const std::uint32_t COMPLEMENT[COMPLEMENT_WORDS];  // 2^256 - MODULUS, about 2^128.3
+	
+	public: static const Scalar LAMBDA;  // Cube root of unity, where LAMBDA * (x, y) = (CurvePoint::BETA * x, y)
+	
+	private: static const Scalar MINUS_B1;  // Lattice basis vectors for splitLambda()
+	private: static const Scalar MINUS_B2;
+	private: static const Uint256 G1;  // Round(2^384 * b2 / order)
+	private: static const Uint256 G2;  // Round(2^384 * (-b1) / order)
+	
+};
@@ -0,0 +1,288 @@
+/* 
+ * A runnable main program that tests the functionality of class Scalar.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "TestHelper.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include "Scalar.hpp"
+#include "Uint256.hpp"
+
+
+/*---- Structures ----*/
+
+struct BinaryCase {
+	const char *x;
+	const char *y;
+};
+
+struct TernaryCase {
+	const char *x;
+	const char *y;
+	const char *z;
+};
+
+
+// Global variables
+static int numTestCases = 0;
+
+
+/*---- Test cases ----*/
+
+static void testAdd() {
+	const vector<TernaryCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "0000000000000000000000000000000000000000000000000000000000000003", "0000000000000000000000000000000000000000000000000000000000000001"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "8000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000000000014551231950B75FC4402DA1732FC9BEBF"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "349B9F27EB1F67A1B6C2D45D946CC538432006ED6089680AA7347BCF95DACAA2", "349B9F27EB1F67A1B6C2D45D946CC538432006ED6089680AA7347BCF95DACAA0"},
+		{"0020000000000000000000000000000200180000000000000000000100004000", "FF70FEFBBDCEFFDBF5FDDF37CFFAFAFFFBED5B769ECFFE2EF77FBEF7BFFFFF87", "FF90FEFBBDCEFFDBF5FDDF37CFFAFB01FC055B769ECFFE2EF77FBEF8C0003F87"},
+		{"0000000000004200000000000000024000024102000800000000000000200000", "B3367BFFBF9FF7AF3B3FE55FFEFFEFFF9FFD3FEF3EFA7F67FBFE8BFDFFBFFBAA", "B3367BFFBFA039AF3B3FE55FFEFFF23F9FFF80F13F027F67FBFE8BFDFFDFFBAA"},
+		{"14BC11524630EA038175632011D861A21BB0CAD414993384098384EFDABAC3A8", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFDBAAEDCE6AF48A03BBFD25E8CD0364141", "14BC11524630EA038175632011D861A11BB0CAD414993384098384EFDABAC3A8"},
+		{"14BC11524630EA038175632011D861A21BB0CAD414993384098384EFDABAC3A8", "0020000000000000000000000000000200180000000000000000000100004000", "14DC11524630EA038175632011D861A41BC8CAD414993384098384F0DABB03A8"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "B3367BFFBF9FF7AF3B3FE55FFEFFEFFF9FFD3FEF3EFA7F67FBFE8BFDFFBFFBAA", "B3367BFFBF9FF7AF3B3FE55FFEFFEFFF9FFD3FEF3EFA7F67FBFE8BFDFFBFFBA8"},
+		{"0000000000000000000000000000000000000000000000000000000000000002", "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000002"},
+		{"91008A0000A01B0412018308080062202004D03A000C00400400000409203000", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFDBAAEDCE6AF48A03BBFD25E8CD0364141", "91008A0000A01B04120183080800621F2004D03A000C00400400000409203000"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFDBAAEDCE6AF48A03BBFD25E8CD0364141", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFDBAAEDCE6AF48A03BBFD25E8CD036413F"},
+	};
+	for (const TernaryCase &tc : cases) {
+		Scalar x(tc.x);
+		x.add(Scalar(tc.y));
+		assert(x == Scalar(tc.z));
+		numTestCases++;
+	}
+}
+
+
+static void testSubtract() {
+	const vector<TernaryCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "0000000000000000000000000000000000000000000000000000000000000002"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "0000000000000000000000000000000000000000000000000000000000000003", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413C"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "8000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"FFFFBFFEFFFFFFBBE7FFFBFBFBFFFFFFFFFFFFFFEFFAFFFFFFFEFFFFFFDFFFFF", "FFFFBFFEFFFFFFBBE7FFFBFBFBFFFFFFFFFFFFFFEFFAFFFFFFFEFFFFFFDFFFFF", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000100000000000000000000000000000000", "FF70FEFBBDCEFFDBF5FDDF37CFFAFAFFFBED5B769ECFFE2EF77FBEF7BFFFFF87", "008F0104423100240A0220C8300504FFBEC181701078A20CC8529F95103641BA"},
+		{"FF70FEFBBDCEFFDBF5FDDF37CFFAFAFFFBED5B769ECFFE2EF77FBEF7BFFFFF87", "0020000000000000000000000000000200180000000000000000000100004000", "FF50FEFBBDCEFFDBF5FDDF37CFFAFAFDFBD55B769ECFFE2EF77FBEF6BFFFBF87"},
+		{"349B9F27EB1F67A1B6C2D45D946CC538432006ED6089680AA7347BCF95DACAA2", "0000000000000000000000000000000000000000000000000000000000000001", "349B9F27EB1F67A1B6C2D45D946CC538432006ED6089680AA7347BCF95DACAA1"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "14BC11524630EA038175632011D861A21BB0CAD414993384098384EFDABAC3A8", "EB43EEADB9CF15FC7E8A9CDFEE279E5C9EFE12129AAF6CB7B64ED99CF57B7D97"},
+		{"14BC11524630EA038175632011D861A21BB0CAD414993384098384EFDABAC3A8", "0000000000004200000000000000024000024102000800000000000000200000", "14BC11524630A8038175632011D85F621BAE89D214913384098384EFDA9AC3A8"},
+		{"B3367BFFBF9FF7AF3B3FE55FFEFFEFFF9FFD3FEF3EFA7F67FBFE8BFDFFBFFBAA", "FFFFFFBFFFFFFFBFFFFDFFFFFFFFFBFFFFFFFFFFFFFFFFFFFFFFFFFFF7FBEFFF", "B3367C3FBF9FF7EF3B41E55FFEFFF3FE5AAC1CD5EE431FA3BBD0EA8AD7FA4CEC"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "8000000000000000000000000000000000000000000000000000000000000000", "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"},
+		{"14BC11524630EA038175632011D861A21BB0CAD414993384098384EFDABAC3A8", "91008A0000A01B0412018308080062202004D03A000C00400400000409203000", "83BB87524590CEFF6F73E01809D7FF80B65AD780C3D5D37FC555E378A1D0D4E9"},
+	};
+	for (const TernaryCase &tc : cases) {
+		Scalar x(tc.x);
+		x.subtract(Scalar(tc.y));
+		assert(x == Scalar(tc.z));
+		numTestCases++;
+	}
+}
+
+
+static void testNegate() {
+	const vector<BinaryCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"},
+		{"0000000000000000000000000000000000000000000000000000000000000002", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "0000000000000000000000000000000000000000000000000000000000000001"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "0000000000000000000000000000000000000000000000000000000000000002"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141"},
+		{"0000000000000000000000000000000100000000000000000000000000000000", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFDBAAEDCE6AF48A03BBFD25E8CD0364141"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFDBAAEDCE6AF48A03BBFD25E8CD0364141", "0000000000000000000000000000000100000000000000000000000000000000"},
+		{"0000000000004200000000000000024000024102000800000000000000200000", "FFFFFFFFFFFFBDFFFFFFFFFFFFFFFDBEBAAC9BE4AF40A03BBFD25E8CD0164141"},
+		{"0020000000000000000000000000000200180000000000000000000100004000", "FFDFFFFFFFFFFFFFFFFFFFFFFFFFFFFCBA96DCE6AF48A03BBFD25E8BD0360141"},
+		{"210309455401400040021248200014B440E28580241001108100240100A90C04", "DEFCF6BAABFEBFFFBFFDEDB7DFFFEB4A79CC57668B389F2B3ED23A8BCF8D353D"},
+		{"91008A0000A01B0412018308080062202004D03A000C00400400000409203000", "6EFF75FFFF5FE4FBEDFE7CF7F7FF9DDE9AAA0CACAF3C9FFBBBD25E88C7161141"},
+		{"349B9F27EB1F67A1B6C2D45D946CC538432006ED6089680AA7347BCF95DACAA2", "CB6460D814E0985E493D2BA26B933AC6778ED5F94EBF3831189DE2BD3A5B769F"},
+		{"14BC11524630EA038175632011D861A21BB0CAD414993384098384EFDABAC3A8", "EB43EEADB9CF15FC7E8A9CDFEE279E5C9EFE12129AAF6CB7B64ED99CF57B7D99"},
+		{"FF70FEFBBDCEFFDBF5FDDF37CFFAFAFFFBED5B769ECFFE2EF77FBEF7BFFFFF87", "008F0104423100240A0220C8300504FEBEC181701078A20CC8529F95103641BA"},
+		{"B3367BFFBF9FF7AF3B3FE55FFEFFEFFF9FFD3FEF3EFA7F67FBFE8BFDFFBFFBAA", "4CC9840040600850C4C01AA001000FFF1AB19CF7704E20D3C3D3D28ED0764597"},
+		{"FFFFFFBFFFFFFFBFFFFDFFFFFFFFFBFFFFFFFFFFFFFFFFFFFFFFFFFFF7FBEFFF", "000000400000004000020000000003FEBAAEDCE6AF48A03BBFD25E8CD83A5142"},
+		{"FFFFBFFEFFFFFFBBE7FFFBFBFBFFFFFFFFFFFFFFEFFAFFFFFFFEFFFFFFDFFFFF", "00004001000000441800040403FFFFFEBAAEDCE6BF4DA03BBFD35E8CD0564142"},
+	};
+	for (const BinaryCase &tc : cases) {
+		Scalar x(tc.x);
+		x.negate();
+		assert(x == Scalar(tc.y));
+		numTestCases++;
+	}
+}
+
+
+static void testMultiply() {
+	const vector<TernaryCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "0000000000000000000000000000000000000000000000000000000000000001"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "0000000000000000000000000000000000000000000000000000000000000003", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413B"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "8000000000000000000000000000000000000000000000000000000000000000", "2759C7356071A6F179A5FD7916F341F19D0525B0839F3E1E225B3C8519F5F450"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "0000000000004200000000000000024000024102000800000000000000200000", "DD18C4430546D0E70296744588D06200545FF678473E1BCEB1C2232C3307D28D"},
+		{"349B9F27EB1F67A1B6C2D45D946CC538432006ED6089680AA7347BCF95DACAA2", "0000000000000000000000000000000000000000000000000000000000000001", "349B9F27EB1F67A1B6C2D45D946CC538432006ED6089680AA7347BCF95DACAA2"},
+		{"FF70FEFBBDCEFFDBF5FDDF37CFFAFAFFFBED5B769ECFFE2EF77FBEF7BFFFFF87", "0000000000000000000000000000000000000000000000000000000000000002", "FEE1FDF77B9DFFB7EBFBBE6F9FF5F6013D2BDA068E575C222F2D1F62AFC9BDCD"},
+		{"0000000000000000000000000000000000000000000000000000000000000000", "14BC11524630EA038175632011D861A21BB0CAD414993384098384EFDABAC3A8", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"FFFFBFFEFFFFFFBBE7FFFBFBFBFFFFFFFFFFFFFFEFFAFFFFFFFEFFFFFFDFFFFF", "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000004200000000000000024000024102000800000000000000200000", "210309455401400040021248200014B440E28580241001108100240100A90C04", "B905FCD7C9545904C85965C50BCABB5CE6C5074AF186BD9EBBB1C08285F4BC12"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "FFFFBFFEFFFFFFBBE7FFFBFBFBFFFFFFFFFFFFFFEFFAFFFFFFFEFFFFFFDFFFFF", "03154FB7614009CCF4270CDC5018400D773EA2108371442D0852A5851E2B3CBB"},
+		{"0000000000000000000000000000000000000000000000000000000000000000", "8000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"FF70FEFBBDCEFFDBF5FDDF37CFFAFAFFFBED5B769ECFFE2EF77FBEF7BFFFFF87", "8000000000000000000000000000000000000000000000000000000000000000", "BC2EC6143017C9EDCA9EB22136F361715D6B92FFCFDEDC76C718037FF55BC7F6"},
+		{"0000000000004200000000000000024000024102000800000000000000200000", "14BC11524630EA038175632011D861A21BB0CAD414993384098384EFDABAC3A8", "DD0FFBACE39870ABDE8EBDD1B677FE9BE58EAD1D23F56CFD3EA0181153ECF6A6"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000002", "000000000000000000000000000000014551231950B75FC4402DA1732FC9BEBF"},
+		{"0000000000000000000000000000000000000000000000000000000000000002", "0020000000000000000000000000000200180000000000000000000100004000", "0040000000000000000000000000000400300000000000000000000200008000"},
+		{"349B9F27EB1F67A1B6C2D45D946CC538432006ED6089680AA7347BCF95DACAA2", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "96C8C1B029C130BC927A5744D726758E346ECF0BEE35D026716966EDA480ABFD"},
+	};
+	for (const TernaryCase &tc : cases) {
+		Scalar x(tc.x);
+		x.multiply(Scalar(tc.y));
+		assert(x == Scalar(tc.z));
+		Scalar y(tc.y);
+		y.multiply(Scalar(tc.x));
+		assert(y == x);
+		numTestCases++;
+	}
+}
+
+
+static void testReciprocal() {
+	const vector<BinaryCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "0000000000000000000000000000000000000000000000000000000000000001"},
+		{"0000000000000000000000000000000000000000000000000000000000000002", "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF5D576E7357A4501DDFE92F46681B20A1"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD036413F", "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF5D576E7357A4501DDFE92F46681B20A0"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "B3D1121AC929DF2712FE61824F9F56BBBCC8CBC65001783D4227E69A30F93EEB"},
+		{"0000000000000000000000000000000100000000000000000000000000000000", "50A51AC834B9EC244B0DFF665588B13E9984D5B3CF80EF0FD6A23766A3EE9F22"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFDBAAEDCE6AF48A03BBFD25E8CD0364141", "AF5AE537CB4613DBB4F20099AA774EC0212A0732DFC7B12BE93027262C47A21F"},
+		{"0000000000004200000000000000024000024102000800000000000000200000", "CEE5BEA3EDFA2E8AE16CC20810DA457D8CA407DD2C724607D88B6E3A125CD5D1"},
+		{"0020000000000000000000000000000200180000000000000000000100004000", "4B379379465F38AE4AFD9C3647AF18FE7FE8DA3CB3288A901BED5B93A515BBEB"},
+		{"210309455401400040021248200014B440E28580241001108100240100A90C04", "B0594889C9D13184EE04A4FE9FB62E299B3707FD52A22835421D66238F04BCC6"},
+		{"91008A0000A01B0412018308080062202004D03A000C00400400000409203000", "793FEF34ECA98AD59D7B95E449C5434145AA05301D20CC804FEAD692FFF40C0F"},
+		{"349B9F27EB1F67A1B6C2D45D946CC538432006ED6089680AA7347BCF95DACAA2", "67041AA731DCEACEE55877164D690161DE337EDAB8E3A26F357F7F9D845186F0"},
+		{"14BC11524630EA038175632011D861A21BB0CAD414993384098384EFDABAC3A8", "ACE96F6FFF41EC046D8FD1A3D120BCA9978DB324608B782F11884B031250968A"},
+		{"FF70FEFBBDCEFFDBF5FDDF37CFFAFAFFFBED5B769ECFFE2EF77FBEF7BFFFFF87", "49E36CD3E27A842123479F22A20B18E833F37D0240D8E78667C4EDE25228C472"},
+		{"B3367BFFBF9FF7AF3B3FE55FFEFFEFFF9FFD3FEF3EFA7F67FBFE8BFDFFBFFBAA", "67F73A2AFCBECD018B34093084F72A66C6196C93D9F669662BBF62311924B006"},
+		{"FFFFFFBFFFFFFFBFFFFDFFFFFFFFFBFFFFFFFFFFFFFFFFFFFFFFFFFFF7FBEFFF", "E9B22C7CA38BD41AB3667313A4C262A4158C7CA93154D0B3900072E5F18BC244"},
+		{"FFFFBFFEFFFFFFBBE7FFFBFBFBFFFFFFFFFFFFFFEFFAFFFFFFFEFFFFFFDFFFFF", "A034F335A039A1597B844C5BA9D2FD29BE5C06284054E36D5E243EAABC79F3C3"},
+	};
+	for (const BinaryCase &tc : cases) {
+		Scalar x(tc.x);
+		x.reciprocal();
+		assert(x == Scalar(tc.y));
+		numTestCases++;
+	}
+	for (const BinaryCase &tc : cases) {
+		Scalar x(tc.x);
+		x.reciprocalVar();
+		assert(x == Scalar(tc.y));
+		numTestCases++;
+	}
+	
+	// Batches of every length, including the zero case and empty batches
+	for (std::size_t len = 0; len <= cases.size(); len++) {
+		for (int variant = 0; variant < 2; variant++) {
+			vector<Scalar> vals;
+			vector<Scalar> scratch;
+			for (std::size_t i = 0; i < len; i++) {
+				vals.push_back(Scalar(cases.at(cases.size() - 1 - i).x));
+				scratch.push_back(Scalar(Uint256::ZERO));
+			}
+			if (variant == 0)
+				Scalar::reciprocalBatch(vals.data(), len, scratch.data());
+			else
+				Scalar::reciprocalBatchVar(vals.data(), len, scratch.data());
+			for (std::size_t i = 0; i < len; i++)
+				assert(vals.at(i) == Scalar(cases.at(cases.size() - 1 - i).y));
+			numTestCases++;
+		}
+	}
+}
+
+
+static void testSplitLambda() {
+	const vector<TernaryCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "0000000000000000000000000000000000000000000000000000000000000001", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"00000000000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEA5E48BEF0665AC4568114DFF32F17168", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE8A280AC50774346DD765CDA83DB1562C"},
+		{"0000000000000000000000000000000100000000000000000000000000000000", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEA5E48BEF0665AC4568114DFF32F17169", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE8A280AC50774346DD765CDA83DB1562C"},
+		{"5363AD4CC05C30E0A5261C028812645A122E22EA20816678DF02967C1B23BD72", "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000001"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"AC9C52B33FA3CF1F5AD9E3FD77ED9BA4A880B9FC8EC739C2E0CFC810B51283CF", "0000000000000000000000000000000000000000000000000000000000000000", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"},
+		{"7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF5D576E7357A4501DDFE92F46681B20A0", "00000000000000000000000000000000A2A8918CA85BAFE22016D0B917E4DD76", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE60D0868C82AB920E7C5E672A9418C46A"},
+		{"7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF5D576E7357A4501DDFE92F46681B20A1", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE18064B5A06ECF0599FBB8DD3B85163CB", "0000000000000000000000000000000059DE565A2C9D0E2D4373F7623C1D7CD7"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "00000000000000000000000000000000000000000000000000000000800001E9", "0000000000000000000000000000000059DE565A2C9D0E2D4373F7623C1D7CD7"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFDBAAEDCE6AF48A03BBFD25E8CD0364141", "0000000000000000000000000000000014CA50F7A8E2F3F657C1108D9D44CFD8", "000000000000000000000000000000003086D221A7D46BCDE86C90E49284EB15"},
+		{"AD38835EDDD6FF552FA73207237751AA4462EBFC5F915EF09CFBAC6E7687A66E", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEB38FC789E75B3C791E66629F111D8CF0", "00000000000000000000000000000000349879FD9A7DD16DC19FBA5C6910C8E9"},
+		{"558298E214B044D79ACD8ACDE5F6DB1D76B6745180B65386569C803601A5BA50", "000000000000000000000000000000000C73782961557255FDC386CE437372BF", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE8068A308A6DF43190167FE2FF5410E89"},
+		{"2B5EBAA061076DC3BA6ACE6C0A78250FB339A4769DDCC6F8EFB6FBFE8DE4AB47", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE9D338A3FD6E433422D210AC42C1B546A", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE97ADA2DFA7704CC0622FA9EC50586C8C"},
+		{"2B1E1885283B73A66C2EA417B99DE255F386825473B7A490F23B2CC4B4174A67", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEA8F6CAD4FAB9AE0A1C9B4768FF2C2954", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE89BDD095F3797C4734137AE95B4B1AF5"},
+		{"FDB119A9EC801BDFDF2965B3819AD93B21E6A46F1C670EA90D243A163CEE5E2C", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEB1B04DF547062DA1AC64D02941C7706B", "000000000000000000000000000000000913C9687B3D25CFE530E98659C244F1"},
+		{"E323BB2ABF00188DCA22E4C76237DBE6B03DA701C632976A10363C5F972651DA", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEA310CC04754ADCBDE2F65285AB88EC62", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE5F2C2148C43A1EF9A79B248C3AE95884"},
+		{"CB01C357B9C7E435396BCB8FAC9ABB0C3478442B4A8AA593EB40A9B81A070205", "0000000000000000000000000000000052BB9947D4B9E7FFE851F1BDA6B58864", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE799F14E0EEC4B8D455719EE1881E7BF8"},
+		{"6583D61435BB5C11E95027004448A6A1C5C7D1861674518DE3BB41B36BF82959", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE97E79A9043E340E3BA39C418E293F49C", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE4E51C891B9761B4229A142E4C8E2F4F0"},
+		{"01597AC1E2EB17C8B573F6C5331155190B0ECF26CF3C17E55777039E47FBB3B4", "00000000000000000000000000000000384C169F5F739EBA697EC30B11B78640", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE94F54DE93DB01A52634EFE269281D622"},
+		{"239EDD3A7DE0D208D886C5D060FA1C95E553FB510E06ACD4694398C5E11E99FB", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE5A73986E85E336F9C94B9BAF80EF280C", "00000000000000000000000000000000485402C9FA224311676EDA2D2E733C34"},
+		{"F6C986F21CAF107AD9C98C23E80A86CFBC79CE036CBACCF13C9A8DF50602FE0C", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE21E1A09ACC7338DA11D46D207347BEC9", "000000000000000000000000000000003F5B988A59507B5EA24DA9280A7E66D5"},
+		{"DA298ADEE5329B4E329A86139425B3E2C3AD4D991F0916CB00FDED6598CAE043", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE321C49323B70B9B2D253F505E9016A63", "0000000000000000000000000000000050BEF0C8CFC27987E2F11BA66A6F19A8"},
+		{"EAEB999B8A2E547E22184E8215607DF9E4794195021CD6FF548914EF33FB4B4F", "00000000000000000000000000000000040BD1D65BE33A357A3F992204C7C7C4", "00000000000000000000000000000000309EC5C991A5D7B263C952737140F7F6"},
+	};
+	for (const TernaryCase &tc : cases) {
+		const Scalar k(tc.x);
+		Scalar r1(Uint256::ZERO), r2(Uint256::ZERO);
+		Scalar::splitLambda(k, r1, r2);
+		assert(r1 == Scalar(tc.y) && r2 == Scalar(tc.z));
+		numTestCases++;
+		
+		Scalar::splitLambdaVar(k, r1, r2);
+		if (Uint256(k) < Uint256("0000000000000000000000000000000100000000000000000000000000000000"))
+			assert(r1 == k && r2 == Scalar(Uint256::ZERO));
+		else
+			assert(r1 == Scalar(tc.y) && r2 == Scalar(tc.z));
+		numTestCases++;
+	}
+}
+
+
+static void testConstructorUint256() {
+	const vector<BinaryCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "0000000000000000000000000000000000000000000000000000000000000001"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364142", "0000000000000000000000000000000000000000000000000000000000000001"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "000000000000000000000000000000014551231950B75FC4402DA1732FC9BEBE"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE", "000000000000000000000000000000014551231950B75FC4402DA1732FC9BEBD"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCF6AF48A03BBFD25E8CD0364141", "0000000000000000000000000000000000000010000000000000000000000000"},
+		{"5D98EC9FED38EE2DC7FB6D95B95F45238B8A41CBD136572BBCF1D11C9886AB97", "5D98EC9FED38EE2DC7FB6D95B95F45238B8A41CBD136572BBCF1D11C9886AB97"},
+		{"280C66A2037AF0DF729B8F03FA94882AE7712C6C787A197863803F0766074C43", "280C66A2037AF0DF729B8F03FA94882AE7712C6C787A197863803F0766074C43"},
+		{"46DB8B3F5FC1C0C7E5144F17C766BBF7397742037D8B7E1B132935ABC664A8A3", "46DB8B3F5FC1C0C7E5144F17C766BBF7397742037D8B7E1B132935ABC664A8A3"},
+		{"1423216ACA6FB73D9F5ACA17DE6C1DE146344036CEFCBD74A27604815114CEFD", "1423216ACA6FB73D9F5ACA17DE6C1DE146344036CEFCBD74A27604815114CEFD"},
+		{"B7A52F2E3FF4EDAC2BFF238E58E643A0D30C6529125FFDAC7FD2AD46F5F7D2C7", "B7A52F2E3FF4EDAC2BFF238E58E643A0D30C6529125FFDAC7FD2AD46F5F7D2C7"},
+		{"FA6B10620A64FE218616C9A907B85F29C90CD0963ADDDCB004015AE6A045D63C", "FA6B10620A64FE218616C9A907B85F29C90CD0963ADDDCB004015AE6A045D63C"},
+	};
+	for (const BinaryCase &tc : cases) {
+		Scalar x((Uint256(tc.x)));
+		assert(x == Scalar(tc.y));
+		assert(Uint256(x) == Uint256(tc.y));
+		numTestCases++;
+	}
+}
+
+
+int main() {
+	testAdd();
+	testSubtract();
+	testNegate();
+	testMultiply();
+	testReciprocal();
+	testSplitLambda();
+	testConstructorUint256();
+	std::printf("All %d test cases passed\n", numTestCases);
+	return EXIT_SUCCESS;
+}
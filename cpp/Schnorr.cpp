@@ -0,0 +1,181 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include <cassert>
+#include <cstring>
+#include "CountOps.hpp"
+#include "CurvePoint.hpp"
+#include "FieldInt.hpp"
+#include "PublicScalar.hpp"
+#include "Scalar.hpp"
+#include "Schnorr.hpp"
+
+using std::uint8_t;
+using std::uint32_t;
+
+
+void Schnorr::getPublicKey(const Uint256 &privateKey, uint8_t outPublicKey[PUBLIC_KEY_LEN]) {
+	assert(outPublicKey != nullptr);
+	const CurvePoint p = CurvePoint::privateExponentToPublicPoint(privateKey);
+	p.x.getBigEndianBytes(outPublicKey);
+}
+
+
+bool Schnorr::sign(const Uint256 &privateKey, const uint8_t msg[], std::size_t msgLen,
+		const uint8_t auxRand[32], uint8_t outSig[SIGNATURE_LEN]) {
+	/* 
+	 * Algorithm pseudocode:
+	 * if (privateKey outside range [1, order-1]) return false
+	 * p = privateKey * G
+	 * d = p.y is even ? privateKey : order - privateKey
+	 * t = bytes(d) XOR hashAux(auxRand)
+	 * k = hashNonce(t || bytes(p.x) || msg) % order
+	 * if (k == 0) return false
+	 * r = k * G
+	 * if (r.y is odd) k = order - k
+	 * e = hashChallenge(bytes(r.x) || bytes(p.x) || msg) % order
+	 * return bytes(r.x) || bytes((k + e * d) % order)
+	 */
+	countOps(functionOps);
+	assert(auxRand != nullptr && outSig != nullptr);
+	
+	const Uint256 &order = CurvePoint::ORDER;
+	const Uint256 &zero = Uint256::ZERO;
+	if (privateKey == zero || privateKey >= order)
+		return false;
+	countOps(2 * arithmeticOps);
+	
+	const CurvePoint p = CurvePoint::privateExponentToPublicPoint(privateKey);
+	Scalar d(privateKey);
+	Scalar negD = d;
+	negD.negate();
+	d.replace(negD, p.y.value[0] & 1);
+	uint8_t px[PUBLIC_KEY_LEN];
+	p.x.getBigEndianBytes(px);
+	countOps(1 * curvepointCopyOps);
+	countOps(2 * uint256CopyOps);
+	
+	uint8_t t[32];
+	d.getBigEndianBytes(t);
+	Sha256 auxHasher = getAuxHasher();
+	const Sha256Hash auxHash = auxHasher.append(auxRand, 32).getHash();
+	for (int i = 0; i < 32; i++)
+		t[i] ^= auxHash.value[i];
+	
+	Sha256 nonceHasher = getNonceHasher();
+	const Sha256Hash nonceHash = nonceHasher.append(t, sizeof(t)).append(px, sizeof(px)).append(msg, msgLen).getHash();
+	Scalar k((Uint256(nonceHash.value)));
+	if (k == Scalar(zero))
+		return false;
+	countOps(1 * uint256CopyOps);
+	
+	const CurvePoint r = CurvePoint::privateExponentToPublicPoint(Uint256(k));
+	Scalar negK = k;
+	negK.negate();
+	k.replace(negK, r.y.value[0] & 1);
+	uint8_t rx[32];
+	r.x.getBigEndianBytes(rx);
+	countOps(1 * curvepointCopyOps);
+	countOps(2 * uint256CopyOps);
+	
+	Sha256 challengeHasher = getChallengeHasher();
+	const Sha256Hash challenge = challengeHasher.append(rx, sizeof(rx)).append(px, sizeof(px)).append(msg, msgLen).getHash();
+	Scalar s((Uint256(challenge.value)));
+	s.multiply(d);
+	s.add(k);
+	std::memcpy(&outSig[0], rx, sizeof(rx));
+	s.getBigEndianBytes(&outSig[32]);
+	countOps(1 * uint256CopyOps);
+	return true;
+}
+
+
+bool Schnorr::verify(const uint8_t publicKey[PUBLIC_KEY_LEN], const uint8_t msg[], std::size_t msgLen,
+		const uint8_t sig[SIGNATURE_LEN]) {
+	/* 
+	 * Algorithm pseudocode:
+	 * p = the point with x coordinate publicKey and an even y coordinate
+	 * if (p does not exist) return false
+	 * r = sig[0 : 32], s = sig[32 : 64]
+	 * if (r >= modulus || s >= order) return false
+	 * e = hashChallenge(bytes(r) || bytes(p.x) || msg) % order
+	 * q = s * G - e * p
+	 * return q != zero && q.x == r && q.y is even
+	 */
+	countOps(functionOps);
+	assert(publicKey != nullptr && sig != nullptr);
+	
+	// Lift the x coordinate to the point with an even y coordinate
+	uint8_t compressed[33];
+	compressed[0] = 0x02;
+	std::memcpy(&compressed[1], publicKey, PUBLIC_KEY_LEN);
+	CurvePoint p = CurvePoint::ZERO;
+	if (!CurvePoint::fromCompressedPointVar(compressed, p))
+		return false;
+	countOps(1 * curvepointCopyOps);
+	
+	const Uint256 r(&sig[0]);
+	const Uint256 s(&sig[32]);
+	const FieldInt fr(r);
+	if (Uint256(fr) != r || s >= CurvePoint::ORDER)
+		return false;
+	countOps(2 * arithmeticOps);
+	
+	Sha256 challengeHasher = getChallengeHasher();
+	const Sha256Hash challenge = challengeHasher.append(&sig[0], 32).append(publicKey, PUBLIC_KEY_LEN).append(msg, msgLen).getHash();
+	Scalar negE((Uint256(challenge.value)));
+	negE.negate();
+	countOps(2 * uint256CopyOps);
+	
+	CurvePoint q = CurvePoint::multiplyGeneratorVar(PublicScalar(s));
+	p.multiplyVar(PublicScalar(negE));
+	q.add(p);
+	if (q.isZero())
+		return false;
+	countOps(1 * curvepointCopyOps);
+	
+	// Compare the x coordinate without normalizing (q.x / q.z == r iff q.x == r * q.z), and then compute only y
+	FieldInt rz = fr;
+	rz.multiply(q.z);
+	if (q.x != rz)
+		return false;
+	FieldInt qy = q.z;
+	qy.reciprocalVar();
+	qy.multiply(q.y);
+	countOps(2 * fieldintCopyOps);
+	countOps(2 * arithmeticOps);
+	return (qy.value[0] & 1) == 0;
+}
+
+
+const Sha256 &Schnorr::getAuxHasher() {
+	static const Sha256 hasher = makeTaggedHasher("BIP0340/aux");
+	return hasher;
+}
+
+
+const Sha256 &Schnorr::getNonceHasher() {
+	static const Sha256 hasher = makeTaggedHasher("BIP0340/nonce");
+	return hasher;
+}
+
+
+const Sha256 &Schnorr::getChallengeHasher() {
+	static const Sha256 hasher = makeTaggedHasher("BIP0340/challenge");
+	return hasher;
+}
+
+
+Sha256 Schnorr::makeTaggedHasher(const char *tag) {
+	// The prefix is exactly one block, so the returned hasher holds only a midstate and an empty buffer
+	const Sha256Hash tagHash = Sha256::getHash(reinterpret_cast<const uint8_t *>(tag), std::strlen(tag));
+	Sha256 result;
+	result.append(tagHash.value, Sha256Hash::HASH_LEN);
+	result.append(tagHash.value, Sha256Hash::HASH_LEN);
+	return result;
+}
@@ -0,0 +1,59 @@
+/* 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Sha256.hpp"
+#include "Uint256.hpp"
+
+
+/* 
+ * Performs BIP 340 Schnorr signature generation and verification over x-only public keys
+ * (32-byte x coordinates of points with an even y coordinate). Provides just a few static functions.
+ */
+class Schnorr final {
+	
+	public: static constexpr int PUBLIC_KEY_LEN = 32;
+	public: static constexpr int SIGNATURE_LEN = 64;
+	
+	
+	// Computes the x-only public key for the given private key, which must be in the range [1, CurvePoint::ORDER).
+	// Constant-time with respect to the value.
+	public: static void getPublicKey(const Uint256 &privateKey, std::uint8_t outPublicKey[PUBLIC_KEY_LEN]);
+	
+	
+	// Computes the signature of the given message with the given private key and 32 bytes of auxiliary random data,
+	// as specified in BIP 340. Returns true if signing was successful, or false if the private key is outside
+	// the range [1, CurvePoint::ORDER) or the derived nonce is zero (vanishing probability). The message can
+	// have any length. outSig is assigned iff signing is successful. All successful executions are constant-time
+	// with respect to the private key and auxiliary data, but not the message length.
+	public: static bool sign(const Uint256 &privateKey, const std::uint8_t msg[], std::size_t msgLen,
+		const std::uint8_t auxRand[32], std::uint8_t outSig[SIGNATURE_LEN]);
+	
+	
+	// Checks whether the given signature, message, and x-only public key are valid together, as specified in BIP 340.
+	// This function does not need to be constant-time because all inputs are public.
+	public: static bool verify(const std::uint8_t publicKey[PUBLIC_KEY_LEN], const std::uint8_t msg[], std::size_t msgLen,
+		const std::uint8_t sig[SIGNATURE_LEN]);
+	
+	
+	// Returns a hasher that has absorbed SHA-256(tag) || SHA-256(tag) for the respective BIP 340 tag. Each one is
+	// built on the first call (thread-safe in C++11); callers copy it, append their data, and take the hash.
+	private: static const Sha256 &getAuxHasher();
+	private: static const Sha256 &getNonceHasher();
+	private: static const Sha256 &getChallengeHasher();
+	
+	
+	private: static Sha256 makeTaggedHasher(const char *tag);
+	
+	
+	Schnorr() = delete;  // Not instantiable
+	
+};
@@ -0,0 +1,116 @@
+/* 
+ * A runnable main program that tests the functionality of class Schnorr.
+ * 
+ * Bitcoin cryptography library
+ * Copyright (c) Project Nayuki
+ * 
+ * https://www.nayuki.io/page/bitcoin-cryptography-library
+ * https://github.com/nayuki/Bitcoin-Cryptography-Library
+ */
+
+#include "TestHelper.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "CurvePoint.hpp"
+#include "Schnorr.hpp"
+#include "Uint256.hpp"
+
+
+// Global variables
+static int numTestCases = 0;
+
+
+/*---- Test cases ----*/
+
+static void testSign() {
+	// Vectors 0 and 1 are from BIP 340; the rest were computed with its reference implementation
+	struct SignCase {
+		const char *privateKey;
+		const char *auxRand;
+		const char *msg;
+		const char *expectedSig;
+	};
+	const vector<SignCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000003", "0000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000", "E907831F80848D1069A5371B402410364BDF1C5F8307B0084C55F1CE2DCA821525F66A4A85EA8B71E482A74F382D2CE5EBEEE8FDB2172F477DF4900D310536C0"},
+		{"B7E151628AED2A6ABF7158809CF4F3C762E7160F38B4DA56A784D9045190CFEF", "0000000000000000000000000000000000000000000000000000000000000001", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6896BD60EEAE296DB48A229FF71DFE071BDE413E6D43F917DC8DCF8C78DE33418906D11AC976ABCCB20B091292BFF4EA897EFCB639EA871CFA95F6DE339E4B0A"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "", "15A4538204F371149D122C9C0039742676AC4E123658BFF8427DF9126B31D6C4BB403B8DFA8D326AADDD2B89F730AA3FE9E8B75273EEB3779B3B6FBFC5A59ADA"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "0000000000000000000000000000000000000000000000000000000000000000", "00", "CCA5CB053BBBD1346550F4381BE0D3BBFD69E38BE77DF2A0DF8D7576984D757F9EA1BF74D208382EB51C6507ECDCF2F98A8B76A574B5C38A8D38BAD2A4DFF163"},
+		{"8ACCEBE7CCB427D2DBC829F987344543FCF18A73184BADDD93383DC666662E04", "10FB681E5E6F0791F1B4A4462BECAD2D1B8B3D50A3D11C38A64E34B366195285", "", "A34E277384373238FEDBCB3176C9834CA654F40015FD0FA67EED3EC1AFA0FD316906A3D8D274579E2C45A74D6A26EA186C8FA906402458B0B4E8B4255148576B"},
+		{"748E38A9F87AB9F28FEB8A5B27A4470B4CF213464133B7068C2F6A55FA10DAB9", "ED2D28CF2170D32093757D46A88DE344CA68D18DF1D6DC02BC6FE40815E3CF06", "0B", "A0D7D741693B3423960D772DC1B50CD114CB759CABB4FF9A30CE36807949B1C25D332A1B4A6648183659495806095B1114EE5F1031F9607F2D11EC636475F4D1"},
+		{"7AF9D7A33A448D5241AAC64231D6BC8B2207EF8952F513567D19495C2A1A8763", "A53FC925E552274D35B0D342F88DB728F46D02E1614E686D88390ED13E08A3A7", "854E0694EFA13226B65207F51D35F08A91", "C99BEEAB3915F00CDD7A07E410663E1E88F8FFC07A01BAE0127B108E52D295C88EC3EFBABB9406216F4299AE4817C417114223D3232B0D4948767711C7D55051"},
+		{"288F465CBFCE60143E018ACEE5880AF2CBFBD74B0EFB1F3D24F6D0B831DDE352", "C75C1C02B0B18B965CCF1D3416715E7C85144F27CCFB1C6DE3A89285835D9A44", "1AE9A41A42FEE82CA21A34790D3F9500557103D4FA928AF2D38F60F8AA6AFFFA", "786AE2F8B9991474B16DE406E7E7813BCF726B9BEF1BB25F44BF2D335865285123E059EF851267B4ACCC069BC6078D54A6D6433ADBC2D23634E2518B7E4002F9"},
+		{"590FC0B02663CD08D4A355DF11F045F3E4D9E89A57C4F9B06BBFBE4DDE3AA1ED", "9FBE8674AC1B253E16A953F4F7310AE79CA041F85B5517A4DFEB71EA22CF2589", "F5FDE8D9F1A865DD01B02E5FA7A6F40CC847F0F4DCA9496C90C157CC2E6DE2EB", "CE3F5B083C6049F72C693144942AD3B86143F450F112092E38050EEC571D70FC69419ECB814B669A570C96E865C96B16C4F25A1E2857C2237AE3B71A2D720413"},
+		{"783C21DBC86B4A9614E427A97EC62CD7B1668BCBB373651EDE1C4E740E170E80", "574BA865E2EE1E72E092D41DCCFE110B3C8CC322E5805A223E5914698A1F902E", "8CF7976A4787E7BCF8CCE855F37E13ACB0972267362967340B375AF6D92030982DFE66880E479E3E79EF97E8FB99F111F90341421CF769D493724453285A8E27", "57831800DCE0120F0920A6AB604083D70D9FC07FB37C9A93A8B16F8ECD5C505C0881438B816AA9513BB0EA773B9462B5ABB5CD101D991AD11CCBAB39D04A4099"},
+		{"08EE061906192DE0E5272D916357A26906901505C4107F1DCC3EC0C64B37D055", "F8E065FBF8AA7C2E0F32FA6D45571CDE9E60990A68D81417188FED74631B7736", "56BF3F1E312242A619124F386AD292EF008B53570B67A901719A1B4334F96892587B7887421DCEC5A195BFF15D3E163BDCB57C270160762C0C30951DC161D46D0E8A3F28A233C31B65AAFDA3F2362E0FF6B2A706F6782DAD919B4F1A54018DA79D777167", "4D097A82E908F178E8F627917CC437A2305445354814958545F180D7F1DF1949B2CC5FE494FF1F7B49BC7765C31EF63D7F6F3D179EE6C26F51676161A98C4644"},
+	};
+	for (const SignCase &tc : cases) {
+		const Uint256 privateKey(tc.privateKey);
+		const Bytes auxRand = hexBytes(tc.auxRand);
+		const Bytes msg = hexBytes(tc.msg);
+		std::uint8_t sig[Schnorr::SIGNATURE_LEN];
+		assert(Schnorr::sign(privateKey, msg.data(), msg.size(), auxRand.data(), sig));
+		assert(Bytes(sig, sig + sizeof(sig)) == hexBytes(tc.expectedSig));
+		
+		std::uint8_t publicKey[Schnorr::PUBLIC_KEY_LEN];
+		Schnorr::getPublicKey(privateKey, publicKey);
+		assert(Schnorr::verify(publicKey, msg.data(), msg.size(), sig));
+		numTestCases++;
+	}
+	
+	// Private keys out of range
+	const Bytes zeros(32, 0);
+	std::uint8_t sig[Schnorr::SIGNATURE_LEN];
+	assert(!Schnorr::sign(Uint256::ZERO, zeros.data(), zeros.size(), zeros.data(), sig));
+	assert(!Schnorr::sign(CurvePoint::ORDER, zeros.data(), zeros.size(), zeros.data(), sig));
+	numTestCases += 2;
+}
+
+
+static void testVerify() {
+	struct VerifyCase {
+		bool answer;
+		const char *publicKey;
+		const char *msg;
+		const char *sig;
+	};
+	const vector<VerifyCase> cases{
+		{true, "F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9", "0000000000000000000000000000000000000000000000000000000000000000", "E907831F80848D1069A5371B402410364BDF1C5F8307B0084C55F1CE2DCA821525F66A4A85EA8B71E482A74F382D2CE5EBEEE8FDB2172F477DF4900D310536C0"},
+		{true, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6896BD60EEAE296DB48A229FF71DFE071BDE413E6D43F917DC8DCF8C78DE33418906D11AC976ABCCB20B091292BFF4EA897EFCB639EA871CFA95F6DE339E4B0A"},
+		{true, "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "", "15A4538204F371149D122C9C0039742676AC4E123658BFF8427DF9126B31D6C4BB403B8DFA8D326AADDD2B89F730AA3FE9E8B75273EEB3779B3B6FBFC5A59ADA"},
+		{true, "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", "00", "CCA5CB053BBBD1346550F4381BE0D3BBFD69E38BE77DF2A0DF8D7576984D757F9EA1BF74D208382EB51C6507ECDCF2F98A8B76A574B5C38A8D38BAD2A4DFF163"},
+		{true, "C9FFFA7CDA2234F3F5FFE0CA70D7AEB12C73E1BC72B698F2B9F21134B1D07E5D", "", "A34E277384373238FEDBCB3176C9834CA654F40015FD0FA67EED3EC1AFA0FD316906A3D8D274579E2C45A74D6A26EA186C8FA906402458B0B4E8B4255148576B"},
+		{true, "E65C5FFD7E863E389F577CF34FBC108E57C498E5000562D0616312B18DED3F64", "0B", "A0D7D741693B3423960D772DC1B50CD114CB759CABB4FF9A30CE36807949B1C25D332A1B4A6648183659495806095B1114EE5F1031F9607F2D11EC636475F4D1"},
+		{true, "61AA69B3FDE7D262563D758D5A6C0300E88E2ECC569570A401053FF72CA6318B", "854E0694EFA13226B65207F51D35F08A91", "C99BEEAB3915F00CDD7A07E410663E1E88F8FFC07A01BAE0127B108E52D295C88EC3EFBABB9406216F4299AE4817C417114223D3232B0D4948767711C7D55051"},
+		{true, "2C478D90F2EB23F8B7E9F433CA4FEE868CB6EE6BB867F1A78FFF2C1D355C22A9", "1AE9A41A42FEE82CA21A34790D3F9500557103D4FA928AF2D38F60F8AA6AFFFA", "786AE2F8B9991474B16DE406E7E7813BCF726B9BEF1BB25F44BF2D335865285123E059EF851267B4ACCC069BC6078D54A6D6433ADBC2D23634E2518B7E4002F9"},
+		{true, "E22FF256D87B93B7F58748297ADF9F86BD3000AF1387505D043CA661493BFD10", "F5FDE8D9F1A865DD01B02E5FA7A6F40CC847F0F4DCA9496C90C157CC2E6DE2EB", "CE3F5B083C6049F72C693144942AD3B86143F450F112092E38050EEC571D70FC69419ECB814B669A570C96E865C96B16C4F25A1E2857C2237AE3B71A2D720413"},
+		{true, "957279956721814C9011530AA267A2AB91DB3CE7E5C660C92647E12E4F35282A", "8CF7976A4787E7BCF8CCE855F37E13ACB0972267362967340B375AF6D92030982DFE66880E479E3E79EF97E8FB99F111F90341421CF769D493724453285A8E27", "57831800DCE0120F0920A6AB604083D70D9FC07FB37C9A93A8B16F8ECD5C505C0881438B816AA9513BB0EA773B9462B5ABB5CD101D991AD11CCBAB39D04A4099"},
+		{true, "6AC0767BE5933493931E75AB162FDDE468F2B5268B6946C5C46288C12053FDA6", "56BF3F1E312242A619124F386AD292EF008B53570B67A901719A1B4334F96892587B7887421DCEC5A195BFF15D3E163BDCB57C270160762C0C30951DC161D46D0E8A3F28A233C31B65AAFDA3F2362E0FF6B2A706F6782DAD919B4F1A54018DA79D777167", "4D097A82E908F178E8F627917CC437A2305445354814958545F180D7F1DF1949B2CC5FE494FF1F7B49BC7765C31EF63D7F6F3D179EE6C26F51676161A98C4644"},
+		{true, "D69C3509BB99E412E68B0FE8544E72837DFA30746D8BE2AA65975F29D22DC7B9", "4DF3C3F68FCC83B27E9D42C90431A72499F17875C81A599B566C9889B9696703", "00000000000000000000003B78CE563F89A0ED9414F5AA28AD0D96D6795F9C6376AFB1548AF603B3EB45C9F8207DEE1060CB71C04E80F593060B07D28308D7F4"},
+		{false, "EEFDEA4CDB677750A420FEE807EACF21EB9898AE79B9768766E4FAA04A2D4A34", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6896BD60EEAE296DB48A229FF71DFE071BDE413E6D43F917DC8DCF8C78DE33418906D11AC976ABCCB20B091292BFF4EA897EFCB639EA871CFA95F6DE339E4B0A"},  // Public key not on the curve
+		{false, "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6896BD60EEAE296DB48A229FF71DFE071BDE413E6D43F917DC8DCF8C78DE33418906D11AC976ABCCB20B091292BFF4EA897EFCB639EA871CFA95F6DE339E4B0A"},  // Public key not less than the modulus
+		{false, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", "253F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6896BD60EEAE296DB48A229FF71DFE071BDE413E6D43F917DC8DCF8C78DE33418906D11AC976ABCCB20B091292BFF4EA897EFCB639EA871CFA95F6DE339E4B0A"},  // Message changed
+		{false, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6896BD60EEAE296DB48A229FF71DFE071BDE413E6D43F917DC8DCF8C78DE33408906D11AC976ABCCB20B091292BFF4EA897EFCB639EA871CFA95F6DE339E4B0A"},  // r changed
+		{false, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6896BD60EEAE296DB48A229FF71DFE071BDE413E6D43F917DC8DCF8C78DE33418906D11AC976ABCCB20B091292BFF4EA897EFCB639EA871CFA95F6DE339E4B0B"},  // s changed
+		{false, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6896BD60EEAE296DB48A229FF71DFE071BDE413E6D43F917DC8DCF8C78DE334176F92EE5368954334DF4F6ED6D400B14312FE030755E191EC53C67AE9C97F637"},  // s negated
+		{false, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F8906D11AC976ABCCB20B091292BFF4EA897EFCB639EA871CFA95F6DE339E4B0A"},  // r equal to the modulus
+		{false, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "6896BD60EEAE296DB48A229FF71DFE071BDE413E6D43F917DC8DCF8C78DE3341FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141"},  // s equal to the order
+		{false, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "4A298DACAE57395A15D0795DDBFD1DCB564DA82B0F269BC70A74F8220429BA1D8906D11AC976ABCCB20B091292BFF4EA897EFCB639EA871CFA95F6DE339E4B0A"},  // r replaced with another value
+		{false, "DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659", "243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89", "FFF97BD5755EEEA420453A14355235D382F6472F8568A18B2F057A14602975563CC27944640AC607CD107AE10923D9EF7A73C643E166BE5EBEAFA34B1AC553E2"},  // Nonce point with odd y
+	};
+	for (const VerifyCase &tc : cases) {
+		const Bytes publicKey = hexBytes(tc.publicKey);
+		const Bytes msg = hexBytes(tc.msg);
+		const Bytes sig = hexBytes(tc.sig);
+		assert(Schnorr::verify(publicKey.data(), msg.data(), msg.size(), sig.data()) == tc.answer);
+		numTestCases++;
+	}
+}
+
+
+int main() {
+	testSign();
+	testVerify();
+	std::printf("All %d test cases passed\n", numTestCases);
+	return EXIT_SUCCESS;
+}
@@ -6,6 +6,7 @@
  * https://github.com/nayuki/Bitcoin-Cryptography-Library
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include "CountOps.hpp"
@@ -13,6 +14,8 @@
 #include "Utils.hpp"
 
 using std::uint8_t;
+using std::int32_t;
+using std::int64_t;
 using std::uint32_t;
 using std::uint64_t;
 
@@ -45,6 +48,11 @@ Uint256::Uint256(const FieldInt &val) {
 }
 
 
+Uint256::Uint256(const Scalar &val) {
+	std::memcpy(this->value, val.value, sizeof(value));
+}
+
+
 uint32_t Uint256::add(const Uint256 &other, uint32_t enable) {
 	assert(&other != this && (enable >> 1) == 0);
 	countOps(functionOps);
@@ -115,57 +123,335 @@ void Uint256::shiftRight1(uint32_t enable) {
 }
 
 
+// Helper functions for reciprocal() and reciprocalVar(), using signed 30-bit limbs
+static const int NUM_LIMBS30 = 9;  // 270 bits, enough for a signed 257-bit value
+static const int32_t LIMB30_MASK = (INT32_C(1) << 30) - 1;
+
+static int32_t divsteps30(int32_t zeta, uint32_t f0, uint32_t g0, int32_t t[4]);
+static int32_t divsteps30Var(int32_t eta, uint32_t f0, uint32_t g0, int32_t t[4]);
+static void updateDe30(int32_t d[NUM_LIMBS30], int32_t e[NUM_LIMBS30], const int32_t t[4], const int32_t mod[NUM_LIMBS30], uint32_t modInv);
+static void updateFg30(int32_t f[NUM_LIMBS30], int32_t g[NUM_LIMBS30], const int32_t t[4]);
+static void normalize30(int32_t r[NUM_LIMBS30], int32_t sign, const int32_t mod[NUM_LIMBS30]);
+static void toSigned30(const Uint256 &x, int32_t out[NUM_LIMBS30]);
+static void fromSigned30(const int32_t in[NUM_LIMBS30], Uint256 &x);
+
+
 void Uint256::reciprocal(const Uint256 &modulus) {
-	// Extended binary GCD algorithm
+	// Bernstein-Yang "safegcd" with the half-delta divstep variant (see https://eprint.iacr.org/2019/266 and
+	// https://github.com/sipa/safegcd-bounds). Numbers are held in signed 30-bit limbs; f and g are transformed
+	// by batches of 30 divsteps, and d and e track the Bezout coefficients modulo the modulus. The count of
+	// 20 batches is fixed; 590 divsteps always suffice to bring g to zero for 256-bit inputs.
 	assert(&modulus != this && (modulus.value[0] & 1) == 1 && modulus > ONE && *this < modulus);
 	countOps(functionOps);
-	Uint256 x = modulus;
-	Uint256 y = *this;
-	Uint256 a = ZERO;
-	Uint256 b = ONE;
-	Uint256 halfModulus = modulus;
-	countOps(5 * uint256CopyOps);
-	halfModulus.add(ONE);
-	halfModulus.shiftRight1();
+	int32_t mod[NUM_LIMBS30];
+	toSigned30(modulus, mod);
+	int32_t d[NUM_LIMBS30] = {};
+	int32_t e[NUM_LIMBS30] = {1};
+	int32_t f[NUM_LIMBS30];
+	int32_t g[NUM_LIMBS30];
+	std::memcpy(f, mod, sizeof(f));
+	toSigned30(*this, g);
+	int32_t zeta = -1;  // zeta = -(delta + 1/2), where delta is initially 1/2
+	countOps(4 * NUM_LIMBS30 * arithmeticOps);
+	
+	// Inverse of the modulus modulo 2^32, by Newton's method (each step doubles the number of correct bits)
+	uint32_t modInv = modulus.value[0];  // Correct to 3 bits, because modulus * modulus = 1 mod 8
+	for (int i = 0; i < 4; i++) {
+		countOps(loopBodyOps);
+		modInv *= 2 - modulus.value[0] * modInv;
+		countOps(3 * arithmeticOps);
+	}
+	assert(modulus.value[0] * modInv == 1);
+	
+	for (int i = 0; i < 20; i++) {
+		countOps(loopBodyOps);
+		int32_t t[4];
+		zeta = divsteps30(zeta, static_cast<uint32_t>(f[0]), static_cast<uint32_t>(g[0]), t);
+		updateDe30(d, e, t, mod, modInv);
+		updateFg30(f, g, t);
+	}
+	
+	// Now g = 0 and f = +/- gcd = +/- 1 (unless this number is zero), so d = +/- the inverse
+	assert(std::all_of(g, g + NUM_LIMBS30, [](int32_t x) { return x == 0; }));
+	normalize30(d, f[NUM_LIMBS30 - 1], mod);
+	fromSigned30(d, *this);
+}
+
+
+void Uint256::reciprocalVar(const Uint256 &modulus) {
+	// Same structure as reciprocal(), but with the original divstep (tracking eta = -delta), skipping
+	// runs of zero bits in g, and stopping as soon as g becomes zero instead of after a fixed bound
+	assert(&modulus != this && (modulus.value[0] & 1) == 1 && modulus > ONE && *this < modulus);
+	countOps(functionOps);
+	int32_t mod[NUM_LIMBS30];
+	toSigned30(modulus, mod);
+	int32_t d[NUM_LIMBS30] = {};
+	int32_t e[NUM_LIMBS30] = {1};
+	int32_t f[NUM_LIMBS30];
+	int32_t g[NUM_LIMBS30];
+	std::memcpy(f, mod, sizeof(f));
+	toSigned30(*this, g);
+	int32_t eta = -1;  // eta = -delta, where delta is initially 1
+	countOps(4 * NUM_LIMBS30 * arithmeticOps);
+	
+	uint32_t modInv = modulus.value[0];
+	for (int i = 0; i < 4; i++) {
+		countOps(loopBodyOps);
+		modInv *= 2 - modulus.value[0] * modInv;
+		countOps(3 * arithmeticOps);
+	}
 	
-	// Loop invariant: x = a*this mod modulus, and y = b*this mod modulus
-	for (int i = 0; i < NUM_WORDS * 32 * 2; i++) {
+	while (std::any_of(g, g + NUM_LIMBS30, [](int32_t x) { return x != 0; })) {
 		countOps(loopBodyOps);
+		countOps(NUM_LIMBS30 * arithmeticOps);
+		int32_t t[4];
+		eta = divsteps30Var(eta, static_cast<uint32_t>(f[0]), static_cast<uint32_t>(g[0]), t);
+		updateDe30(d, e, t, mod, modInv);
+		updateFg30(f, g, t);
+	}
+	normalize30(d, f[NUM_LIMBS30 - 1], mod);
+	fromSigned30(d, *this);
+}
+
+
+int Uint256::jacobiVar(const Uint256 &modulus) const {
+	// Binary Jacobi symbol algorithm. Loop invariant: result * jacobi(a, n) = jacobi(this, modulus)
+	assert((modulus.value[0] & 1) == 1 && *this < modulus);
+	countOps(functionOps);
+	Uint256 a = *this;
+	Uint256 n = modulus;
+	int result = 1;
+	countOps(2 * uint256CopyOps);
+	countOps(1 * arithmeticOps);
+	while (a != ZERO) {
+		countOps(loopBodyOps);
+		while ((a.value[0] & 1) == 0) {  // jacobi(2, n) = -1 iff n mod 8 is 3 or 5
+			countOps(loopBodyOps);
+			a.shiftRight1();
+			uint32_t nMod8 = n.value[0] & 7;
+			if (nMod8 == 3 || nMod8 == 5)
+				result = -result;
+			countOps(6 * arithmeticOps);
+		}
+		if (a < n) {  // Quadratic reciprocity, where both numbers are odd
+			a.swap(n, 1);
+			if ((a.value[0] & 3) == 3 && (n.value[0] & 3) == 3)
+				result = -result;
+			countOps(6 * arithmeticOps);
+		}
+		a.subtract(n);
+	}
+	return n == ONE ? result : 0;
+}
+
+
+static int32_t divsteps30(int32_t zeta, uint32_t f0, uint32_t g0, int32_t t[4]) {
+	// Performs 30 divsteps on only the low 30 bits of f and g, and returns the transition matrix
+	// [u v; q r] (scaled by 2^30) that would transform the full numbers in the same way. The matrix
+	// elements are in [-2^30, 2^30] but computed as unsigned to keep the left shifts well-defined.
+	countOps(functionOps);
+	uint32_t u = 1, v = 0, q = 0, r = 1;
+	uint32_t f = f0, g = g0;
+	countOps(6 * arithmeticOps);
+	for (int i = 0; i < 30; i++) {
+		countOps(loopBodyOps);
+		assert((f & 1) == 1);
+		// Pseudocode:
+		// if (zeta < 0 && g is odd) { f, g = g, -f; u, v, q, r = q, r, -u, -v; zeta = -zeta - 2 } else zeta -= 1
+		// if (g is odd) { g += f; q += u; r += v }
+		// g /= 2; u *= 2; v *= 2
+		uint32_t mask1 = static_cast<uint32_t>(zeta >> 31);  // All ones iff zeta < 0
+		uint32_t mask2 = -(g & 1);
+		uint32_t x = (f ^ mask1) - mask1;  // Conditionally negated f, u, v
+		uint32_t y = (u ^ mask1) - mask1;
+		uint32_t z = (v ^ mask1) - mask1;
+		g += x & mask2;
+		q += y & mask2;
+		r += z & mask2;
+		mask1 &= mask2;
+		zeta = (zeta ^ static_cast<int32_t>(mask1)) - 1;
+		f += g & mask1;
+		u += q & mask1;
+		v += r & mask1;
+		g >>= 1;
+		u <<= 1;
+		v <<= 1;
+		assert(-601 <= zeta && zeta <= 601);
+		countOps(29 * arithmeticOps);
+	}
+	t[0] = static_cast<int32_t>(u);
+	t[1] = static_cast<int32_t>(v);
+	t[2] = static_cast<int32_t>(q);
+	t[3] = static_cast<int32_t>(r);
+	return zeta;
+}
+
+
+static int32_t divsteps30Var(int32_t eta, uint32_t f0, uint32_t g0, int32_t t[4]) {
+	// Performs 30 original divsteps on the low bits of f and g, shifting out each run of zeros in g at once
+	countOps(functionOps);
+	uint32_t u = 1, v = 0, q = 0, r = 1;
+	uint32_t f = f0, g = g0;
+	countOps(6 * arithmeticOps);
+	for (int i = 30; ; ) {
+		countOps(loopBodyOps);
+		for (; i > 0 && (g & 1) == 0; i--) {
+			countOps(loopBodyOps);
+			g >>= 1;
+			u <<= 1;
+			v <<= 1;
+			eta--;
+			countOps(7 * arithmeticOps);
+		}
+		if (i == 0)
+			break;
 		
-		// Try to reduce a trailing zero of y. Pseudocode:
-		// if (y % 2 == 0) {
-		//     y /= 2
-		//     b = b % 2 == 0 ? b / 2 : modulus - (modulus - b) / 2
-		// }
-		assert((x.value[0] & 1) == 1);
-		uint32_t yEven = (y.value[0] & 1) ^ 1;
-		uint32_t bOdd = b.value[0] & 1;
-		y.shiftRight1(yEven);
-		b.shiftRight1(yEven);
-		b.add(halfModulus, yEven & bOdd);
+		// Now f and g are both odd
+		assert((f & 1) == 1);
+		if (eta < 0) {  // Swap and negate: f, g = g, -f; u, v, q, r = q, r, -u, -v
+			eta = -eta;
+			uint32_t x = f;
+			f = g;
+			g = -x;
+			x = u;
+			u = q;
+			q = -x;
+			x = v;
+			v = r;
+			r = -x;
+			countOps(6 * arithmeticOps);
+		}
+		g += f;  // Makes g even
+		q += u;
+		r += v;
+		countOps(5 * arithmeticOps);
+	}
+	t[0] = static_cast<int32_t>(u);
+	t[1] = static_cast<int32_t>(v);
+	t[2] = static_cast<int32_t>(q);
+	t[3] = static_cast<int32_t>(r);
+	return eta;
+}
+
+
+static void updateDe30(int32_t d[NUM_LIMBS30], int32_t e[NUM_LIMBS30], const int32_t t[4], const int32_t mod[NUM_LIMBS30], uint32_t modInv) {
+	// Computes [d, e] = (t * [d, e] + mod * [md, me]) / 2^30, where md and me are chosen
+	// so that the division is exact and so that the outputs stay in the range (-2 * mod, mod)
+	countOps(functionOps);
+	const int32_t u = t[0], v = t[1], q = t[2], r = t[3];
+	int32_t sd = d[NUM_LIMBS30 - 1] >> 31;  // All ones iff d < 0
+	int32_t se = e[NUM_LIMBS30 - 1] >> 31;
+	int32_t md = (u & sd) + (v & se);
+	int32_t me = (q & sd) + (r & se);
+	int64_t cd = static_cast<int64_t>(u) * d[0] + static_cast<int64_t>(v) * e[0];
+	int64_t ce = static_cast<int64_t>(q) * d[0] + static_cast<int64_t>(r) * e[0];
+	md -= static_cast<int32_t>((modInv * static_cast<uint32_t>(cd) + static_cast<uint32_t>(md)) & LIMB30_MASK);
+	me -= static_cast<int32_t>((modInv * static_cast<uint32_t>(ce) + static_cast<uint32_t>(me)) & LIMB30_MASK);
+	cd += static_cast<int64_t>(mod[0]) * md;
+	ce += static_cast<int64_t>(mod[0]) * me;
+	assert((cd & LIMB30_MASK) == 0 && (ce & LIMB30_MASK) == 0);
+	cd >>= 30;
+	ce >>= 30;
+	countOps(40 * arithmeticOps);
+	for (int i = 1; i < NUM_LIMBS30; i++) {
+		countOps(loopBodyOps);
+		cd += static_cast<int64_t>(u) * d[i] + static_cast<int64_t>(v) * e[i] + static_cast<int64_t>(mod[i]) * md;
+		ce += static_cast<int64_t>(q) * d[i] + static_cast<int64_t>(r) * e[i] + static_cast<int64_t>(mod[i]) * me;
+		d[i - 1] = static_cast<int32_t>(cd & LIMB30_MASK);
+		e[i - 1] = static_cast<int32_t>(ce & LIMB30_MASK);
+		cd >>= 30;
+		ce >>= 30;
+		countOps(24 * arithmeticOps);
+	}
+	d[NUM_LIMBS30 - 1] = static_cast<int32_t>(cd);
+	e[NUM_LIMBS30 - 1] = static_cast<int32_t>(ce);
+}
+
+
+static void updateFg30(int32_t f[NUM_LIMBS30], int32_t g[NUM_LIMBS30], const int32_t t[4]) {
+	// Computes [f, g] = t * [f, g] / 2^30, where the division is exact
+	countOps(functionOps);
+	const int32_t u = t[0], v = t[1], q = t[2], r = t[3];
+	int64_t cf = static_cast<int64_t>(u) * f[0] + static_cast<int64_t>(v) * g[0];
+	int64_t cg = static_cast<int64_t>(q) * f[0] + static_cast<int64_t>(r) * g[0];
+	assert((cf & LIMB30_MASK) == 0 && (cg & LIMB30_MASK) == 0);
+	cf >>= 30;
+	cg >>= 30;
+	countOps(14 * arithmeticOps);
+	for (int i = 1; i < NUM_LIMBS30; i++) {
+		countOps(loopBodyOps);
+		cf += static_cast<int64_t>(u) * f[i] + static_cast<int64_t>(v) * g[i];
+		cg += static_cast<int64_t>(q) * f[i] + static_cast<int64_t>(r) * g[i];
+		f[i - 1] = static_cast<int32_t>(cf & LIMB30_MASK);
+		g[i - 1] = static_cast<int32_t>(cg & LIMB30_MASK);
+		cf >>= 30;
+		cg >>= 30;
+		countOps(16 * arithmeticOps);
+	}
+	f[NUM_LIMBS30 - 1] = static_cast<int32_t>(cf);
+	g[NUM_LIMBS30 - 1] = static_cast<int32_t>(cg);
+}
+
+
+static void normalize30(int32_t r[NUM_LIMBS30], int32_t sign, const int32_t mod[NUM_LIMBS30]) {
+	// Brings r from the range (-2 * mod, mod) to [0, mod), negating it if sign is negative
+	countOps(functionOps);
+	int32_t condAdd = r[NUM_LIMBS30 - 1] >> 31;
+	int32_t condNegate = sign >> 31;
+	for (int i = 0; i < NUM_LIMBS30; i++) {
+		countOps(loopBodyOps);
+		r[i] += mod[i] & condAdd;
+		r[i] = (r[i] ^ condNegate) - condNegate;
+		countOps(5 * arithmeticOps);
+	}
+	for (int i = 0; i < NUM_LIMBS30 - 1; i++) {  // Propagate carries, to bring limbs back to (-2^30, 2^30)
+		countOps(loopBodyOps);
+		r[i + 1] += r[i] >> 30;
+		r[i] &= LIMB30_MASK;
 		countOps(4 * arithmeticOps);
-		
-		// If allowed, try to swap so that y >= x and then do y -= x. Pseudocode:
-		// if (y % 2 == 1) {
-		//     if (x > y) {
-		//         x, y = y, x
-		//         a, b = b, a
-		//     }
-		//     y -= x
-		//     b -= a
-		//     b %= modulus
-		// }
-		uint32_t enable = y.value[0] & 1;
-		uint32_t doswap = enable & static_cast<uint32_t>(x > y);
-		x.swap(y, doswap);
-		y.subtract(x, enable);
-		a.swap(b, doswap);
-		uint32_t borrow = b.subtract(a, enable);
-		b.add(modulus, borrow);
-		countOps(2 * arithmeticOps);
 	}
-	assert((x == ONE) | (x == modulus));  // Either gcd(this, modulus) = 1 or this = 0
-	this->replace(a, static_cast<uint32_t>(*this != ZERO));
+	condAdd = r[NUM_LIMBS30 - 1] >> 31;
+	for (int i = 0; i < NUM_LIMBS30; i++) {
+		countOps(loopBodyOps);
+		r[i] += mod[i] & condAdd;
+		countOps(3 * arithmeticOps);
+	}
+	for (int i = 0; i < NUM_LIMBS30 - 1; i++) {
+		countOps(loopBodyOps);
+		r[i + 1] += r[i] >> 30;
+		r[i] &= LIMB30_MASK;
+		countOps(4 * arithmeticOps);
+	}
+}
+
+
+static void toSigned30(const Uint256 &x, int32_t out[NUM_LIMBS30]) {
+	countOps(functionOps);
+	for (int i = 0; i < NUM_LIMBS30; i++) {
+		countOps(loopBodyOps);
+		int bit = i * 30;
+		uint32_t limb = x.value[bit >> 5] >> (bit & 31);
+		if ((bit & 31) > 2 && (bit >> 5) + 1 < Uint256::NUM_WORDS)
+			limb |= x.value[(bit >> 5) + 1] << (32 - (bit & 31));
+		out[i] = static_cast<int32_t>(limb & LIMB30_MASK);
+		countOps(12 * arithmeticOps);
+	}
+}
+
+
+static void fromSigned30(const int32_t in[NUM_LIMBS30], Uint256 &x) {
+	countOps(functionOps);
+	std::memset(x.value, 0, sizeof(x.value));
+	for (int i = 0; i < NUM_LIMBS30; i++) {
+		countOps(loopBodyOps);
+		assert(0 <= in[i] && in[i] <= LIMB30_MASK);
+		int bit = i * 30;
+		uint32_t limb = static_cast<uint32_t>(in[i]);
+		x.value[bit >> 5] |= limb << (bit & 31);
+		if ((bit & 31) > 2 && (bit >> 5) + 1 < Uint256::NUM_WORDS)
+			x.value[(bit >> 5) + 1] |= limb >> (32 - (bit & 31));
+		countOps(12 * arithmeticOps);
+	}
 }
 
 
@@ -11,6 +11,7 @@
 #include <cstdint>
 
 class FieldInt;  // Forward declaration
+class Scalar;    // Forward declaration
 
 
 /* 
@@ -57,6 +58,11 @@ class Uint256 {
 	public: explicit Uint256(const FieldInt &val);
 	
 	
+	// Constructs a Uint256 from the given Scalar. Constant-time with respect to the given value.
+	// All possible Scalar values are valid.
+	public: explicit Uint256(const Scalar &val);
+	
+	
 	
 	/*---- Arithmetic methods ----*/
 	
@@ -89,6 +95,16 @@ class Uint256 {
 	public: void reciprocal(const Uint256 &modulus);
 	
 	
+	// Computes the multiplicative inverse of this number with respect to the given modulus, with the same
+	// requirements and result as reciprocal(). Not constant-time; only use it on public values.
+	public: void reciprocalVar(const Uint256 &modulus);
+	
+	
+	// Returns the Jacobi symbol of this number with respect to the given modulus, which is -1, 0, or 1.
+	// The modulus must be odd, and this number must be less than the modulus. Not constant-time.
+	public: int jacobiVar(const Uint256 &modulus) const;
+	
+	
 	/*---- Miscellaneous methods ----*/
 	
 	// Copies the given number into this number if enable is 1, or does nothing if enable is 0.
@@ -138,3 +154,4 @@ class Uint256 {
 
 
 #include "FieldInt.hpp"
+#include "Scalar.hpp"
@@ -253,6 +253,12 @@ static void testReciprocal() {
 		{"C0EE5C43AADB01D95B8E7C300DFEDCF2487FE21F02679C16FB44A1B8FE7F8D36", "E5A5FE281AED3487822FFD2442A2484A244A168C0B59215AC3C686C9B650EC7B", "E32701CC43A21E8879595EDA986F1B277EBFA9CA7CA3CDB39B46A361C9588FD0", 0},
 		{"C7DDA628A3D4EE89D5E85E52489E2A0BD4FA7978667FE5A7D8635A3B39E32D52", "E5A5FE281AED3487822FFD2442A2484A244A168C0B59215AC3C686C9B650EC7B", "1E2E6E2076AA8A9B7D957D43FEAB45A7E464B2DE9EA93280C94FDAF3759EB93C", 0},
 		{"CB1091D01C0A0019534FE60409F37B0AB199957E307DCD34375AF0EB28027617", "E5A5FE281AED3487822FFD2442A2484A244A168C0B59215AC3C686C9B650EC7B", "196BC84DA4D52061821DBE6E76F91F616AED7DE5F9AD225BC607602A69DBBCB7", 0},
+		{"0000000000000000000000000000000000000000000000000000000000000000", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141", "0000000000000000000000000000000000000000000000000000000000000000", 0},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141", "0000000000000000000000000000000000000000000000000000000000000001", 0},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", 0},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2E", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2E", 0},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F", "937A320A2AA70733388D85852BE56EC3796447FDB84940B3B070123B10D03625", 0},
+		{"0000000000000000000000000000000000000000000000000000000000000002", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "8000000000000000000000000000000000000000000000000000000000000000", 0},
 	};
 	for (const TernaryCase &tc : cases) {
 		Uint256 x(tc.x);
@@ -260,6 +266,12 @@ static void testReciprocal() {
 		assert(x == Uint256(tc.z));
 		numTestCases++;
 	}
+	for (const TernaryCase &tc : cases) {
+		Uint256 x(tc.x);
+		x.reciprocalVar(Uint256(tc.y));
+		assert(x == Uint256(tc.z));
+		numTestCases++;
+	}
 }
 
 
@@ -34,14 +34,10 @@ extern "C" {
 	// (i.e. Input values are Uint256, not necessarily FieldInt.)
 	void asm_FieldInt_multiply256x256eq512(std::uint32_t z[16], const std::uint32_t x[8], const std::uint32_t y[8]);
 	
-	// Computes (uint768 dest) = (uint512 src) * (2^256 + 2^32 + 0x3D1) % 2^768,
-	// correct for all input values. If src < modulus^2, then the result does not overflow.
-	void asm_FieldInt_multiplyBarrettStep0(std::uint32_t dest[24], const std::uint32_t src[16]);
+	// Computes (uint512 z) = (uint256 x)^2, correct for all input values.
+	void asm_FieldInt_square256eq512(std::uint32_t z[16], const std::uint32_t x[8]);
 	
-	// Computes (uint512 dest) = (uint256 src) * (2^256 - 2^32 - 0x3D1), correct for all input values.
-	void asm_FieldInt_multiplyBarrettStep1(std::uint32_t dest[16], const std::uint32_t src[8]);
-	
-	// Computes (uint288 z) = ((uint512 x) - (uint512 y)) % 2^288, correct for all input values.
-	void asm_FieldInt_multiplyBarrettStep2(std::uint32_t z[9], const std::uint32_t x[16], const std::uint32_t y[16]);
+	// Computes (uint256 dest) = (uint512 src) % (2^256 - 0x1000003D1), correct for all input values.
+	void asm_FieldInt_reduce512(std::uint32_t dest[8], const std::uint32_t src[16]);
 	
 }
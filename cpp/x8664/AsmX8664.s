@@ -281,144 +281,166 @@ asm_FieldInt_multiply256x256eq512:
 	retq
 
 
-/* void asm_FieldInt_multiplyBarrettStep0(uint32_t dest[24], const uint32_t src[16]) */
-.globl asm_FieldInt_multiplyBarrettStep0
-asm_FieldInt_multiplyBarrettStep0:
-	movq   0(%rsi), %rax
-	movq   8(%rsi), %rdx
-	movq  16(%rsi), %r8
-	movq  24(%rsi), %r9
-	movq  %rax, 32(%rdi)
-	movq  %rdx, 40(%rdi)
-	movq  %r8 , 48(%rdi)
-	movq  %r9 , 56(%rdi)
-	movq  32(%rsi), %rax
-	movq  40(%rsi), %rdx
-	movq  48(%rsi), %r8
-	movq  56(%rsi), %r9
-	movq  %rax, 64(%rdi)
-	movq  %rdx, 72(%rdi)
-	movq  %r8 , 80(%rdi)
-	movq  %r9 , 88(%rdi)
+/* void asm_FieldInt_square256eq512(uint32_t z[16], const uint32_t x[8]) */
+.globl asm_FieldInt_square256eq512
+asm_FieldInt_square256eq512:
+	pushq  %rbx
+	pushq  %r12
+	pushq  %r13
+	pushq  %r14
 	
-	movl  0(%rsi), %eax
-	movl  $0, 0(%rdi)
-	movl  %eax, 4(%rdi)
-	movq   4(%rsi), %rax
-	movq  12(%rsi), %rcx
-	movq  20(%rsi), %rdx
-	movq  %rax,  8(%rdi)
-	movq  %rcx, 16(%rdi)
-	movq  %rdx, 24(%rdi)
+	/* Cross products x[i] * x[j] for i < j (in 64-bit words), into r13:r12:r11:r10:r9:r8 */
+	movq  0(%rsi), %rax
+	mulq  8(%rsi)
+	movq  %rax, %r8
+	movq  %rdx, %r9
+	movq  0(%rsi), %rax
+	mulq  16(%rsi)
+	addq  %rax, %r9
+	adcq  $0, %rdx
+	movq  %rdx, %r10
+	movq  0(%rsi), %rax
+	mulq  24(%rsi)
+	addq  %rax, %r10
+	adcq  $0, %rdx
+	movq  %rdx, %r11
+	movq  8(%rsi), %rax
+	mulq  16(%rsi)
+	movl  $0, %r12d
+	addq  %rax, %r10
+	adcq  %rdx, %r11
+	adcq  $0, %r12
+	movq  8(%rsi), %rax
+	mulq  24(%rsi)
+	addq  %rax, %r11
+	adcq  %rdx, %r12
+	movq  16(%rsi), %rax
+	mulq  24(%rsi)
+	movq  %rdx, %r13
+	addq  %rax, %r12
+	adcq  $0, %r13
 	
-	movq  28(%rsi), %rax
-	addq  %rax, 32(%rdi)
-	movq  36(%rsi), %rax
-	adcq  %rax, 40(%rdi)
-	movq  44(%rsi), %rax
-	adcq  %rax, 48(%rdi)
-	movq  52(%rsi), %rax
-	adcq  %rax, 56(%rdi)
+	/* Double the cross products, into r14:r13:r12:r11:r10:r9:r8 */
+	movl  $0, %r14d
+	addq  %r8 , %r8
+	adcq  %r9 , %r9
+	adcq  %r10, %r10
+	adcq  %r11, %r11
+	adcq  %r12, %r12
+	adcq  %r13, %r13
+	adcq  $0, %r14
 	
-	movl  60(%rsi), %eax
-	adcq  %rax, 64(%rdi)
-	adcq  $0, 72(%rdi)
-	adcq  $0, 80(%rdi)
-	adcq  $0, 88(%rdi)
+	/* Add the squares x[i]^2 on the diagonal, saving the carry in rbx across each mulq */
+	movq  0(%rsi), %rax
+	mulq  %rax
+	movq  %rax, %rcx
+	movq  %rdx, %rbx
+	movq  8(%rsi), %rax
+	mulq  %rax
+	addq  %rbx, %r8
+	adcq  %rax, %r9
+	adcq  %rdx, %r10
+	sbbq  %rbx, %rbx
+	movq  16(%rsi), %rax
+	mulq  %rax
+	negq  %rbx
+	adcq  %rax, %r11
+	adcq  %rdx, %r12
+	sbbq  %rbx, %rbx
+	movq  24(%rsi), %rax
+	mulq  %rax
+	negq  %rbx
+	adcq  %rax, %r13
+	adcq  %rdx, %r14
 	
-	movl  $0, %ecx
-	movq  $0, %r8
-.loop0:
-	movl  $0x3D1, %eax
-	mulq  (%rsi,%rcx)
-	addq  %r8, %rax
-	adcq  $0, %rdx
-	addq  %rax, (%rdi,%rcx)
-	adcq  $0, %rdx
-	movq  %rdx, %r8
-	addl  $8, %ecx
-	cmpl  $64, %ecx
-	jb    .loop0
+	movq  %rcx,  0(%rdi)
+	movq  %r8 ,  8(%rdi)
+	movq  %r9 , 16(%rdi)
+	movq  %r10, 24(%rdi)
+	movq  %r11, 32(%rdi)
+	movq  %r12, 40(%rdi)
+	movq  %r13, 48(%rdi)
+	movq  %r14, 56(%rdi)
 	
-	addq  %r8, 64(%rdi)
-	adcq  $0, 72(%rdi)
-	adcq  $0, 80(%rdi)
-	adcq  $0, 88(%rdi)
+	popq  %r14
+	popq  %r13
+	popq  %r12
+	popq  %rbx
 	retq
 
 
-/* void asm_FieldInt_multiplyBarrettStep1(uint32_t dest[16], const uint32_t src[8]) */
-.globl asm_FieldInt_multiplyBarrettStep1
-asm_FieldInt_multiplyBarrettStep1:
-	movq   0(%rsi), %rax
-	movq   8(%rsi), %rcx
-	movq  16(%rsi), %r8
-	movq  24(%rsi), %r9
-	movq  %rax, 32(%rdi)
-	movq  %rcx, 40(%rdi)
-	movq  %r8 , 48(%rdi)
-	movq  %r9 , 56(%rdi)
+/* void asm_FieldInt_reduce512(uint32_t dest[8], const uint32_t src[16]) */
+.globl asm_FieldInt_reduce512
+asm_FieldInt_reduce512:
+	/* Fold the high half: (r11:r10:r9:r8 with top word rcx) = src[0:8] + src[8:16] * 0x1000003D1 */
+	movq   0(%rsi), %r8
+	movq   8(%rsi), %r9
+	movq  16(%rsi), %r10
+	movq  24(%rsi), %r11
+	movl  $0, %ecx
 	
-	movl  0(%rsi), %eax
-	shlq  $32, %rax
-	negq  %rax
-	movq  %rax, 0(%rdi)
-	movl  $0, %eax
-	sbbq  4(%rsi), %rax
-	movq  %rax, 8(%rdi)
-	movl  $0, %eax
-	sbbq  12(%rsi), %rax
-	movq  %rax, 16(%rdi)
-	movl  $0, %eax
-	sbbq  20(%rsi), %rax
-	movq  %rax, 24(%rdi)
-	movl  28(%rsi), %eax
-	sbbq  %rax, 32(%rdi)
-	sbbq  $0, 40(%rdi)
-	sbbq  $0, 48(%rdi)
-	sbbq  $0, 56(%rdi)
+	movabsq  $0x1000003D1, %rax
+	mulq  32(%rsi)
+	addq  %rax, %r8
+	adcq  %rdx, %r9
+	adcq  $0, %r10
+	adcq  $0, %r11
+	adcq  $0, %rcx
+	
+	movabsq  $0x1000003D1, %rax
+	mulq  40(%rsi)
+	addq  %rax, %r9
+	adcq  %rdx, %r10
+	adcq  $0, %r11
+	adcq  $0, %rcx
+	
+	movabsq  $0x1000003D1, %rax
+	mulq  48(%rsi)
+	addq  %rax, %r10
+	adcq  %rdx, %r11
+	adcq  $0, %rcx
 	
+	movabsq  $0x1000003D1, %rax
+	mulq  56(%rsi)
+	addq  %rax, %r11
+	adcq  %rdx, %rcx
+	
+	/* Fold the top word (less than 2^34), which leaves a carry of 0 or 1 */
+	movabsq  $0x1000003D1, %rax
+	mulq  %rcx
 	movl  $0, %ecx
-	movq  $0, %r8
-	movl  $0, %r9d
-.loop1:
-	movl  $0x3D1, %eax
-	mulq  (%rsi,%rcx)
-	addq  %r8, %rax
+	addq  %rax, %r8
+	adcq  %rdx, %r9
+	adcq  $0, %r10
+	adcq  $0, %r11
+	adcq  $0, %rcx
+	
+	/* Fold the carry, which cannot overflow again */
+	negq  %rcx
+	movabsq  $0x1000003D1, %rax
+	andq  %rcx, %rax
+	addq  %rax, %r8
+	adcq  $0, %r9
+	adcq  $0, %r10
+	adcq  $0, %r11
+	
+	/* Subtract the modulus iff value + 0x1000003D1 carries out of 256 bits */
+	movabsq  $0x1000003D1, %rcx
+	movq  %r8 , %rax
+	addq  %rcx, %rax
+	movq  %r9 , %rdx
 	adcq  $0, %rdx
-	negl  %r9d
-	sbbq  %rax, (%rdi,%rcx)
-	movl  $0, %r9d
-	sbbl  $0, %r9d
-	movq  %rdx, %r8
-	addl  $8, %ecx
-	cmpl  $32, %ecx
-	jb    .loop1
+	movq  %r10, %rsi
+	adcq  $0, %rsi
+	movq  %r11, %rcx
+	adcq  $0, %rcx
+	cmovcq  %rax, %r8
+	cmovcq  %rdx, %r9
+	cmovcq  %rsi, %r10
+	cmovcq  %rcx, %r11
 	
-	negl  %r9d
-	sbbq  %r8, 32(%rdi)
-	sbbq  $0, 40(%rdi)
-	sbbq  $0, 48(%rdi)
-	sbbq  $0, 56(%rdi)
-	retq
-
-
-/* void asm_FieldInt_multiplyBarrettStep2(uint32_t z[9], const uint32_t x[16], const uint32_t y[16]) */
-.globl asm_FieldInt_multiplyBarrettStep2
-asm_FieldInt_multiplyBarrettStep2:
-	movq  0(%rsi), %rax
-	subq  0(%rdx), %rax
-	movq  %rax, 0(%rdi)
-	movq  8(%rsi), %rax
-	sbbq  8(%rdx), %rax
-	movq  %rax, 8(%rdi)
-	movq  16(%rsi), %rax
-	sbbq  16(%rdx), %rax
-	movq  %rax, 16(%rdi)
-	movq  24(%rsi), %rax
-	sbbq  24(%rdx), %rax
-	movq  %rax, 24(%rdi)
-	movl  32(%rsi), %eax
-	sbbl  32(%rdx), %eax
-	movl  %eax, 32(%rdi)
+	movq  %r8 ,  0(%rdi)
+	movq  %r9 ,  8(%rdi)
+	movq  %r10, 16(%rdi)
+	movq  %r11, 24(%rdi)
 	retq
@@ -7,7 +7,6 @@
  */
 
 #include <cassert>
-#include <cstring>
 #include "AsmX8664.hpp"
 #include "FieldInt.hpp"
 
@@ -55,7 +54,9 @@ void FieldInt::multiply2() {
 
 
 void FieldInt::square() {
-	multiply(*this);
+	uint32_t product0[NUM_WORDS * 2];
+	asm_FieldInt_square256eq512(&product0[0], &this->value[0]);
+	reduce512(product0);
 }
 
 
@@ -64,24 +65,13 @@ void FieldInt::multiply(const FieldInt &other) {
 	uint32_t product0[NUM_WORDS * 2];
 	asm_FieldInt_multiply256x256eq512(&product0[0], &this->value[0], &other.value[0]);
 	
-	// Barrett reduction algorithm begins here (see https://www.nayuki.io/page/barrett-reduction-algorithm).
-	// Multiply by floor(2^512 / MODULUS), which is 2^256 + 2^32 + 0x3D1. Guaranteed to fit in a uint768.
-	uint32_t product1[NUM_WORDS * 3];
-	asm_FieldInt_multiplyBarrettStep0(product1, product0);
-	
-	// Virtually shift right by 512 bits, then multiply by MODULUS.
-	// Note that MODULUS = 2^256 - 2^32 - 0x3D1. Result fits in a uint512.
-	uint32_t product2[NUM_WORDS * 2];
-	asm_FieldInt_multiplyBarrettStep1(product2, &product1[NUM_WORDS * 2]);
-	
-	// Compute product0 - product2, which fits in a uint257 (sic)
-	uint32_t difference[NUM_WORDS + 1];
-	asm_FieldInt_multiplyBarrettStep2(difference, product0, product2);
-	
-	// Final conditional subtraction to yield a FieldInt value
-	std::memcpy(this->value, difference, sizeof(value));
-	uint32_t dosub = static_cast<uint32_t>((difference[NUM_WORDS] != 0) | (*this >= MODULUS));
-	Uint256::subtract(MODULUS, dosub);
+	reduce512(product0);
+}
+
+
+void FieldInt::reduce512(const uint32_t product0[NUM_WORDS * 2]) {
+	// Special-form reduction, using 2^256 = 0x1000003D1 (mod MODULUS)
+	asm_FieldInt_reduce512(&this->value[0], &product0[0]);
 }
 
 
@@ -90,6 +80,117 @@ void FieldInt::reciprocal() {
 }
 
 
+void FieldInt::reciprocalVar() {
+	Uint256::reciprocalVar(MODULUS);
+}
+
+
+void FieldInt::reciprocalBatch(FieldInt vals[], std::size_t len, FieldInt scratch[]) {
+	/* 
+	 * Montgomery's trick: with scratch[i] = v[0] * ... * v[i] (using 1 in place of zero values), invert only
+	 * scratch[len-1], then walk backward: 1/v[i] = 1/scratch[i] * scratch[i-1], and 1/scratch[i-1] = 1/scratch[i] * v[i].
+	 */
+	if (len == 0)
+		return;
+	const FieldInt zero(Uint256::ZERO);
+	const FieldInt one(Uint256::ONE);
+	FieldInt acc = one;
+	for (std::size_t i = 0; i < len; i++) {
+		FieldInt v = vals[i];
+		v.replace(one, static_cast<uint32_t>(v == zero));
+		acc.multiply(v);
+		scratch[i] = acc;
+	}
+	acc.reciprocal();
+	for (std::size_t i = len; i-- > 0; ) {
+		FieldInt v = vals[i];
+		uint32_t isZero = static_cast<uint32_t>(v == zero);
+		v.replace(one, isZero);
+		FieldInt inv = acc;
+		if (i > 0)  // Depends only on the public loop index
+			inv.multiply(scratch[i - 1]);
+		acc.multiply(v);
+		inv.replace(zero, isZero);
+		vals[i] = inv;
+	}
+}
+
+
+void FieldInt::reciprocalBatchVar(FieldInt vals[], std::size_t len, FieldInt scratch[]) {
+	// Same algorithm as reciprocalBatch(), but zero values are skipped by branching
+	const FieldInt zero(Uint256::ZERO);
+	FieldInt acc(Uint256::ONE);
+	for (std::size_t i = 0; i < len; i++) {
+		if (vals[i] != zero)
+			acc.multiply(vals[i]);
+		scratch[i] = acc;
+	}
+	acc.reciprocalVar();
+	for (std::size_t i = len; i-- > 0; ) {
+		if (vals[i] == zero)
+			continue;
+		FieldInt inv = acc;
+		if (i > 0)
+			inv.multiply(scratch[i - 1]);
+		acc.multiply(vals[i]);
+		vals[i] = inv;
+	}
+}
+
+
+int FieldInt::jacobiVar() const {
+	return Uint256::jacobiVar(MODULUS);
+}
+
+
+bool FieldInt::sqrt() {
+	/* 
+	 * The prime is 3 mod 4, so if x is a square then x^((p+1)/4) is a square root of x. In binary, the exponent
+	 * is 223 ones, 1 zero, 22 ones, 4 zeros, 2 ones, 2 zeros. The addition chain (from libsecp256k1) builds
+	 * x^(2^k - 1) for the block lengths k it needs, using 253 squarings and 13 multiplications in total.
+	 */
+	const FieldInt &x1 = *this;
+	FieldInt x2 = x1;
+	x2.squareRepeatMultiply(1, x1);
+	FieldInt x3 = x2;
+	x3.squareRepeatMultiply(1, x1);
+	FieldInt x6 = x3;
+	x6.squareRepeatMultiply(3, x3);
+	FieldInt x9 = x6;
+	x9.squareRepeatMultiply(3, x3);
+	FieldInt x11 = x9;
+	x11.squareRepeatMultiply(2, x2);
+	FieldInt x22 = x11;
+	x22.squareRepeatMultiply(11, x11);
+	FieldInt x44 = x22;
+	x44.squareRepeatMultiply(22, x22);
+	FieldInt x88 = x44;
+	x88.squareRepeatMultiply(44, x44);
+	FieldInt result = x88;
+	result.squareRepeatMultiply(88, x88);  // 176 ones
+	result.squareRepeatMultiply(44, x44);  // 220 ones
+	result.squareRepeatMultiply(3, x3);    // 223 ones
+	result.squareRepeatMultiply(23, x22);
+	result.squareRepeatMultiply(6, x2);
+	result.square();
+	result.square();
+	
+	FieldInt check = result;
+	check.square();
+	bool isSquare = check == *this;
+	this->replace(result, static_cast<uint32_t>(isSquare));
+	return isSquare;
+}
+
+
+void FieldInt::squareRepeatMultiply(int n, const FieldInt &other) {
+	for (int i = 0; i < n; i++) {
+		square();
+	}
+	multiply(other);
+}
+
+
 void FieldInt::replace(const FieldInt &other, uint32_t enable) {
 	Uint256::replace(other, enable);
 }
@@ -31,6 +31,11 @@ struct TernaryCase {
 	const char *z;
 };
 
+struct JacobiCase {
+	const char *x;
+	int y;
+};
+
 
 // Global variables
 static int numTestCases = 0;
@@ -269,6 +274,52 @@ static void testReciprocal() {
 		assert(x == FieldInt(tc.y));
 		numTestCases++;
 	}
+	for (const BinaryCase &tc : cases) {
+		FieldInt x(tc.x);
+		x.reciprocalVar();
+		assert(x == FieldInt(tc.y));
+		numTestCases++;
+	}
+}
+
+
+static void testJacobiVar() {
+	const vector<JacobiCase> cases{
+		{"0000000000000000000000000000000000000000000000000000000000000000", 0},
+		{"0000000000000000000000000000000000000000000000000000000000000001", 1},
+		{"0000000000000000000000000000000000000000000000000000000000000002", 1},
+		{"0000000000000000000000000000000000000000000000000000000000000003", -1},
+		{"0000000000000000000000000000000000000000000000000000000000000004", 1},
+		{"0000000000000000000000000000000000000000000000000000000000000007", -1},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2E", -1},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2D", -1},
+		{"8000000000000000000000000000000000000000000000000000000000000000", 1},
+		{"79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798", 1},
+		{"0B3510B0B46EE1DA317017A6205738D16018366CF658F7A75ED34FE53A096533", 1},
+		{"6694F229359B154881A0D5B3FFC6E35CCFAF00103F584AD4230824D215CEB3A1", -1},
+		{"92B850AD7EB72F8263F65DA874007CB47CC661E97589CA4A07C15471A4517D6C", 1},
+		{"C24F6AA83BF36A147C2F7AD016EDC5D467164890D49D0AC1E5B8063831360A40", -1},
+		{"E941AA79E6EDAF80796D3BC4685CA8AF852A5FBA444ADF42B37F5722051E2670", -1},
+		{"D0718C1AFDD9A78D18DFF3934223AA56A9B7E3EA1D1D784FB9DB434B610B1631", 1},
+		{"0EDCA4ECA92D04A31B941F4360908405D45C39A39EC353C162E917D310269470", 1},
+		{"844DBC0CA65423A9E744B24E7F61701E1607B1C4B0F913063C02E56756A3E957", 1},
+		{"8A2AD16E107AC8069B51C6322463278ECEF2D30194DF943C353A0106E6C08269", 1},
+		{"DC3D716BF22FF5FD25F0F21231A06A7CB3AA75AB7D1944FF09974B85F2306D4A", 1},
+		{"8EAC871F492091F271F47E49E18692E295990881BA9BE85A74CDA9C49436D6F6", -1},
+		{"99EF936AC3A8DB5628865529228DC5196D16328FE0C99F3EDAE3DF9C5B507A36", -1},
+		{"A4D70DFCF3332EB05B6659EAB3BFCD5D50545214B0AFB81E8824918818FD64F7", -1},
+		{"5B11B76F2670E0984F0CF267329911DA9FBD873580ED55037EA03260D7EF27BB", 1},
+		{"DB522231E7397785CEE116191248A2A4A834D5808281A6BF48CB74A9875A34F2", 1},
+		{"E86C68CD3E6F54D4581DA689384EF90A8B80EB31B3880DE0E9BE9F8881E6187F", -1},
+		{"4138CAD26C64107F089D8567444FC6F938443E4F57DE014C4BB36EC8030CF05D", 1},
+		{"A84E090A2CDD3FBE6ABB3E13E4373A7DB494D2A8D595BF234C60DED1607E39D1", 1},
+		{"068FE849F98F7A0DDA23CEA1A9C59A2DEEBB31672A8AE1661DC35C7F65718DDC", 1},
+		{"CBE20B1103623AE41DD1D6164CCFBBBF2922071DC437B057F91B60E533A9B4BB", -1},
+	};
+	for (const JacobiCase &tc : cases) {
+		assert(FieldInt(tc.x).jacobiVar() == tc.y);
+		numTestCases++;
+	}
 }
 
 
@@ -314,43 +365,58 @@ static void testAsmMultiply256x256eq512() {
 }
 
 
-static void testAsmMultiplyBarrettStep0() {
+static void testAsmSquare256eq512() {
 	const vector<BinaryCase> cases{
-		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "00000000000000000000000000000000000000000000000000000001000003D0FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F"},
-		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF00000000000000000000000000000000000000000000000000000000FFFFFFFFFFFFFFFF", "00000000000000000000000000000000000000000000000000000000000003D0FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFC2EFFFFFFFF0000000000000000000000000000000000000001000003D0FFFFFFFEFFFFFC2F"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE0000000000000000000000000000000000000000000000000000000000000001"},
+		{"0000000000000000000000000000000000000000000000000000000000000000", "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000000000000000000000000000000000001", "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001"},
+		{"8000000000000000000000000000000000000000000000000000000000000000", "40000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"},
+		{"8000000000000000800000000000000080000000000000008000000000000000", "40000000000000008000000000000000C0000000000000010000000000000000C000000000000000800000000000000040000000000000000000000000000000"},
+		{"000000000000000000000000000000000000000000000000FFFFFFFFFFFFFFFF", "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000FFFFFFFFFFFFFFFE0000000000000001"},
+		{"FFFFFFFFFFFFFFFF000000000000000000000000000000000000000000000000", "FFFFFFFFFFFFFFFE0000000000000001000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"},
+		{"E9BB466A287385820942DC06BC69F2658575062102FBCD4F357FBC5AF71A1BFC", "D5666F2D30179BF073E736CBCBDB99238F56DDA92C222B14DBB4961F847EC7BAEBB7A275A1D3DF4DFA4743915EB5326FC44E10393A3E9447220131D9FA3F2010"},
+		{"25B2116AAE6CFF55CE0C3F08E12656F10E11160004524A7C3D2BD371FC80BE13", "058CF4E50FF5690143E7452D8F1C1CF841AFDC9DB639419DC7FF61F30B9008948944CB96E1D0BF84EDB82407820477671F6BB316700C653A046AD5BA08203569"},
+		{"77616364568C43961DFC388C3D5DF9725E06E22DFFF3F4ECB1DCEC40DB7ACA58", "37ABAF73C116BF64FEC0A870964AB1BB3BBC09B8E0947669B0950B34F8FF114DAA6760315EE36110D5F8E42305F5450358304476C82D7E3255E2BD180BCEFE40"},
 	};
 	for (const BinaryCase &tc : cases) {
-		uint32_t src[16];
-		for (int j = 0; j < 16; j++)
-			sscanf(&tc.x[j * 8], "%08" SCNx32, &src[15 - j]);
-		uint32_t dest[24];
-		asm_FieldInt_multiplyBarrettStep0(&dest[0], &src[0]);
-		for (int j = 0; j < 24; j++) {
+		Uint256 x(tc.x);
+		uint32_t z[16];
+		asm_FieldInt_square256eq512(&z[0], &x.value[0]);
+		for (int j = 0; j < 16; j++) {
 			uint32_t word;
 			sscanf(&tc.y[j * 8], "%08" SCNx32, &word);
-			assert(word == dest[23 - j]);
+			assert(word == z[15 - j]);
 		}
 		numTestCases++;
 	}
 }
 
 
-static void testAsmMultiplyBarrettStep1() {
+static void testAsmReduce512() {
 	const vector<BinaryCase> cases{
-		{"8000000000000000000000000000000000000000000000000000000000000000", "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF7FFFFE178000000000000000000000000000000000000000000000000000000000000000"},
-		{"8000000000000000000000000000000000000000000000000000000080000001", "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE187FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF7FFFFE167FFFFC2F"},
-		{"000000000000000000000000000000000043142D118E47CB983CCA48D7E8F111", "000000000000000000000000000000000043142D118E47CB983CCA48D7E8F110FFFFFFFFFFFFFFFFFFFFFFFFFFBCEBD1EE71B83467C335B728170EEEFFFFFE1F"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "000000000000000000000000000000000000000000000001000007A2000E90A0"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFDFFFFF85C000000000000000000000000000000000000000000000001000007A4000E9844", "0000000000000000000000000000000000000000000000000000000000000001"},
+		{"00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"0000000000000000000000000000000000000000000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000000", "00000000000000000000000000000000000000000000000000000001000003D1"},
+		{"0000000000000000000000000000000000000000000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", "00000000000000000000000000000000000000000000000000000001000003D0"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2E", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2E"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000000000000000000000000001000007A1000E8CD0"},
+		{"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFDFFFFF85E000000000000000000000000000000000000000000000001000007A2000E90A1", "0000000000000000000000000000000000000000000000000000000000000000"},
+		{"732242FDA8902E3212979BFCBBEB508F4A800646417A8105BC3199944567CEB13F372617F0BAEF3A86F0CE2EA6EC39C1C15521B1B3DCA50A9DAA37E51B591D75", "4D88FE5A5192D85037766E471E7AB2E3556794D75494A5828F7F6BDF624D25BB"},
+		{"CECF4F4E5BA8078050CEF798E6C648E7DEEDA8B23927F7D64375D0341E4F6F2AE8AF30F7C70B53BF64D0B50F658C6762DF7142DCAF29E6F877744CCA4D909EB2", "8984E283E41EEC0CB175EC7FFF364CFEE19A0ADF14288FE4D932A8553FF14DA0"},
+		{"0000000000000000000000000000000000000000000000000000000000000001FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFDFFFFF85E", "0000000000000000000000000000000000000000000000000000000000000000"},
 	};
 	for (const BinaryCase &tc : cases) {
-		uint32_t src[8];
-		for (int j = 0; j < 8; j++)
-			sscanf(&tc.x[j * 8], "%08" SCNx32, &src[7 - j]);
-		uint32_t dest[16];
-		asm_FieldInt_multiplyBarrettStep1(&dest[0], &src[0]);
-		for (int j = 0; j < 16; j++) {
+		uint32_t src[16];
+		for (int j = 0; j < 16; j++)
+			sscanf(&tc.x[j * 8], "%08" SCNx32, &src[15 - j]);
+		uint32_t dest[8];
+		asm_FieldInt_reduce512(&dest[0], &src[0]);
+		for (int j = 0; j < 8; j++) {
 			uint32_t word;
 			sscanf(&tc.y[j * 8], "%08" SCNx32, &word);
-			assert(word == dest[15 - j]);
+			assert(word == dest[7 - j]);
 		}
 		numTestCases++;
 	}
@@ -365,10 +431,11 @@ int main() {
 	testMultiply();
 	testSquare();
 	testReciprocal();
+	testJacobiVar();
 	testConstructorUint256();
 	testAsmMultiply256x256eq512();
-	testAsmMultiplyBarrettStep0();
-	testAsmMultiplyBarrettStep1();
+	testAsmSquare256eq512();
+	testAsmReduce512();
 	std::printf("All %d test cases passed\n", numTestCases);
 	return EXIT_SUCCESS;
 }
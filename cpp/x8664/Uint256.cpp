@@ -13,6 +13,7 @@
 #include "Utils.hpp"
 
 using std::uint8_t;
+using std::int64_t;
 using std::uint32_t;
 using std::uint64_t;
 
@@ -45,6 +46,11 @@ Uint256::Uint256(const FieldInt &val) {
 }
 
 
+Uint256::Uint256(const Scalar &val) {
+	std::memcpy(this->value, val.value, sizeof(value));
+}
+
+
 uint32_t Uint256::add(const Uint256 &other, uint32_t enable) {
 	assert(&other != this && (enable >> 1) == 0);
 	return asm_Uint256_add(&this->value[0], &other.value[0], enable);
@@ -68,51 +74,277 @@ void Uint256::shiftRight1(uint32_t enable) {
 }
 
 
+// Helper functions for reciprocal(), using signed 62-bit limbs and 128-bit intermediates
+static const int NUM_LIMBS62 = 5;  // 310 bits, enough for a signed 257-bit value
+static const int64_t LIMB62_MASK = (INT64_C(1) << 62) - 1;
+
+static int64_t divsteps62(int64_t zeta, uint64_t f0, uint64_t g0, int64_t t[4]);
+static int64_t divsteps62Var(int64_t eta, uint64_t f0, uint64_t g0, int64_t t[4]) {
+	// Performs 62 original divsteps on the low bits of f and g, shifting out each run of zeros in g at once
+	uint64_t u = 1, v = 0, q = 0, r = 1;
+	uint64_t f = f0, g = g0;
+	for (int i = 62; ; ) {
+		int zeros = __builtin_ctzll(g | (~UINT64_C(0) << i));  // Well-defined because i is at most 62
+		g >>= zeros;
+		u <<= zeros;
+		v <<= zeros;
+		eta -= zeros;
+		i -= zeros;
+		if (i == 0)
+			break;
+		
+		// Now f and g are both odd
+		assert((f & 1) == 1 && (g & 1) == 1);
+		if (eta < 0) {  // Swap and negate: f, g = g, -f; u, v, q, r = q, r, -u, -v
+			eta = -eta;
+			uint64_t x = f;
+			f = g;
+			g = -x;
+			x = u;
+			u = q;
+			q = -x;
+			x = v;
+			v = r;
+			r = -x;
+		}
+		g += f;  // Makes g even
+		q += u;
+		r += v;
+	}
+	t[0] = static_cast<int64_t>(u);
+	t[1] = static_cast<int64_t>(v);
+	t[2] = static_cast<int64_t>(q);
+	t[3] = static_cast<int64_t>(r);
+	return eta;
+}
+
+
+static void updateDe62(int64_t d[NUM_LIMBS62], int64_t e[NUM_LIMBS62], const int64_t t[4], const int64_t mod[NUM_LIMBS62], uint64_t modInv);
+static void updateFg62(int64_t f[NUM_LIMBS62], int64_t g[NUM_LIMBS62], const int64_t t[4]);
+static void normalize62(int64_t r[NUM_LIMBS62], int64_t sign, const int64_t mod[NUM_LIMBS62]);
+static void toSigned62(const Uint256 &x, int64_t out[NUM_LIMBS62]);
+static void fromSigned62(const int64_t in[NUM_LIMBS62], Uint256 &x);
+
+
 void Uint256::reciprocal(const Uint256 &modulus) {
-	// Extended binary GCD algorithm
+	// Bernstein-Yang "safegcd" with the half-delta divstep variant, in batches of 62 divsteps
+	// on signed 62-bit limbs. 10 batches (620 divsteps) always suffice for 256-bit inputs.
 	assert(&modulus != this && (modulus.value[0] & 1) == 1 && modulus > ONE && *this < modulus);
-	Uint256 x = modulus;
-	Uint256 y = *this;
-	Uint256 a = ZERO;
-	Uint256 b = ONE;
-	Uint256 halfModulus = modulus;
-	halfModulus.add(ONE);
-	halfModulus.shiftRight1();
+	int64_t mod[NUM_LIMBS62];
+	toSigned62(modulus, mod);
+	int64_t d[NUM_LIMBS62] = {};
+	int64_t e[NUM_LIMBS62] = {1};
+	int64_t f[NUM_LIMBS62];
+	int64_t g[NUM_LIMBS62];
+	std::memcpy(f, mod, sizeof(f));
+	toSigned62(*this, g);
+	int64_t zeta = -1;  // zeta = -(delta + 1/2), where delta is initially 1/2
 	
-	// Loop invariant: x = a*this mod modulus, and y = b*this mod modulus
-	for (int i = 0; i < NUM_WORDS * 32 * 2; i++) {
-		// Try to reduce a trailing zero of y. Pseudocode:
-		// if (y % 2 == 0) {
-		//     y /= 2
-		//     b = b % 2 == 0 ? b / 2 : modulus - (modulus - b) / 2
-		// }
-		assert((x.value[0] & 1) == 1);
-		uint32_t yEven = (y.value[0] & 1) ^ 1;
-		uint32_t bOdd = b.value[0] & 1;
-		y.shiftRight1(yEven);
-		b.shiftRight1(yEven);
-		b.add(halfModulus, yEven & bOdd);
-		
-		// If allowed, try to swap so that y >= x and then do y -= x. Pseudocode:
-		// if (y % 2 == 1) {
-		//     if (x > y) {
-		//         x, y = y, x
-		//         a, b = b, a
-		//     }
-		//     y -= x
-		//     b -= a
-		//     b %= modulus
-		// }
-		uint32_t enable = y.value[0] & 1;
-		uint32_t doswap = enable & static_cast<uint32_t>(x > y);
-		x.swap(y, doswap);
-		y.subtract(x, enable);
-		a.swap(b, doswap);
-		uint32_t borrow = b.subtract(a, enable);
-		b.add(modulus, borrow);
+	// Inverse of the modulus modulo 2^64, by Newton's method
+	uint64_t mod0 = static_cast<uint64_t>(modulus.value[1]) << 32 | modulus.value[0];
+	uint64_t modInv = mod0;
+	for (int i = 0; i < 5; i++)
+		modInv *= 2 - mod0 * modInv;
+	assert(mod0 * modInv == 1);
+	
+	for (int i = 0; i < 10; i++) {
+		int64_t t[4];
+		zeta = divsteps62(zeta, static_cast<uint64_t>(f[0]), static_cast<uint64_t>(g[0]), t);
+		updateDe62(d, e, t, mod, modInv);
+		updateFg62(f, g, t);
+	}
+	
+	// Now g = 0 and f = +/- gcd = +/- 1 (unless this number is zero), so d = +/- the inverse
+	assert((g[0] | g[1] | g[2] | g[3] | g[4]) == 0);
+	normalize62(d, f[NUM_LIMBS62 - 1], mod);
+	fromSigned62(d, *this);
+}
+
+
+void Uint256::reciprocalVar(const Uint256 &modulus) {
+	// Same structure as reciprocal(), but with the original divstep (tracking eta = -delta), skipping
+	// runs of zero bits in g, and stopping as soon as g becomes zero instead of after a fixed bound
+	assert(&modulus != this && (modulus.value[0] & 1) == 1 && modulus > ONE && *this < modulus);
+	int64_t mod[NUM_LIMBS62];
+	toSigned62(modulus, mod);
+	int64_t d[NUM_LIMBS62] = {};
+	int64_t e[NUM_LIMBS62] = {1};
+	int64_t f[NUM_LIMBS62];
+	int64_t g[NUM_LIMBS62];
+	std::memcpy(f, mod, sizeof(f));
+	toSigned62(*this, g);
+	int64_t eta = -1;  // eta = -delta, where delta is initially 1
+	
+	uint64_t mod0 = static_cast<uint64_t>(modulus.value[1]) << 32 | modulus.value[0];
+	uint64_t modInv = mod0;
+	for (int i = 0; i < 5; i++)
+		modInv *= 2 - mod0 * modInv;
+	
+	while ((g[0] | g[1] | g[2] | g[3] | g[4]) != 0) {
+		int64_t t[4];
+		eta = divsteps62Var(eta, static_cast<uint64_t>(f[0]), static_cast<uint64_t>(g[0]), t);
+		updateDe62(d, e, t, mod, modInv);
+		updateFg62(f, g, t);
+	}
+	normalize62(d, f[NUM_LIMBS62 - 1], mod);
+	fromSigned62(d, *this);
+}
+
+
+int Uint256::jacobiVar(const Uint256 &modulus) const {
+	// Binary Jacobi symbol algorithm. Loop invariant: result * jacobi(a, n) = jacobi(this, modulus)
+	assert((modulus.value[0] & 1) == 1 && *this < modulus);
+	Uint256 a = *this;
+	Uint256 n = modulus;
+	int result = 1;
+	while (a != ZERO) {
+		while ((a.value[0] & 1) == 0) {  // jacobi(2, n) = -1 iff n mod 8 is 3 or 5
+			a.shiftRight1();
+			uint32_t nMod8 = n.value[0] & 7;
+			if (nMod8 == 3 || nMod8 == 5)
+				result = -result;
+		}
+		if (a < n) {  // Quadratic reciprocity, where both numbers are odd
+			a.swap(n, 1);
+			if ((a.value[0] & 3) == 3 && (n.value[0] & 3) == 3)
+				result = -result;
+		}
+		a.subtract(n);
+	}
+	return n == ONE ? result : 0;
+}
+
+
+static int64_t divsteps62(int64_t zeta, uint64_t f0, uint64_t g0, int64_t t[4]) {
+	uint64_t u = 1, v = 0, q = 0, r = 1;
+	uint64_t f = f0, g = g0;
+	for (int i = 0; i < 62; i++) {
+		assert((f & 1) == 1);
+		uint64_t mask1 = static_cast<uint64_t>(zeta >> 63);  // All ones iff zeta < 0
+		uint64_t mask2 = -(g & 1);
+		uint64_t x = (f ^ mask1) - mask1;
+		uint64_t y = (u ^ mask1) - mask1;
+		uint64_t z = (v ^ mask1) - mask1;
+		g += x & mask2;
+		q += y & mask2;
+		r += z & mask2;
+		mask1 &= mask2;
+		zeta = (zeta ^ static_cast<int64_t>(mask1)) - 1;
+		f += g & mask1;
+		u += q & mask1;
+		v += r & mask1;
+		g >>= 1;
+		u <<= 1;
+		v <<= 1;
+	}
+	t[0] = static_cast<int64_t>(u);
+	t[1] = static_cast<int64_t>(v);
+	t[2] = static_cast<int64_t>(q);
+	t[3] = static_cast<int64_t>(r);
+	return zeta;
+}
+
+
+static void updateDe62(int64_t d[NUM_LIMBS62], int64_t e[NUM_LIMBS62], const int64_t t[4], const int64_t mod[NUM_LIMBS62], uint64_t modInv) {
+	const int64_t u = t[0], v = t[1], q = t[2], r = t[3];
+	int64_t sd = d[NUM_LIMBS62 - 1] >> 63;
+	int64_t se = e[NUM_LIMBS62 - 1] >> 63;
+	int64_t md = (u & sd) + (v & se);
+	int64_t me = (q & sd) + (r & se);
+	__int128 cd = static_cast<__int128>(u) * d[0] + static_cast<__int128>(v) * e[0];
+	__int128 ce = static_cast<__int128>(q) * d[0] + static_cast<__int128>(r) * e[0];
+	md -= static_cast<int64_t>((modInv * static_cast<uint64_t>(cd) + static_cast<uint64_t>(md)) & LIMB62_MASK);
+	me -= static_cast<int64_t>((modInv * static_cast<uint64_t>(ce) + static_cast<uint64_t>(me)) & LIMB62_MASK);
+	cd += static_cast<__int128>(mod[0]) * md;
+	ce += static_cast<__int128>(mod[0]) * me;
+	assert((static_cast<int64_t>(cd) & LIMB62_MASK) == 0 && (static_cast<int64_t>(ce) & LIMB62_MASK) == 0);
+	cd >>= 62;
+	ce >>= 62;
+	for (int i = 1; i < NUM_LIMBS62; i++) {
+		cd += static_cast<__int128>(u) * d[i] + static_cast<__int128>(v) * e[i];
+		ce += static_cast<__int128>(q) * d[i] + static_cast<__int128>(r) * e[i];
+		cd += static_cast<__int128>(mod[i]) * md;
+		ce += static_cast<__int128>(mod[i]) * me;
+		d[i - 1] = static_cast<int64_t>(cd) & LIMB62_MASK;
+		e[i - 1] = static_cast<int64_t>(ce) & LIMB62_MASK;
+		cd >>= 62;
+		ce >>= 62;
+	}
+	d[NUM_LIMBS62 - 1] = static_cast<int64_t>(cd);
+	e[NUM_LIMBS62 - 1] = static_cast<int64_t>(ce);
+}
+
+
+static void updateFg62(int64_t f[NUM_LIMBS62], int64_t g[NUM_LIMBS62], const int64_t t[4]) {
+	const int64_t u = t[0], v = t[1], q = t[2], r = t[3];
+	__int128 cf = static_cast<__int128>(u) * f[0] + static_cast<__int128>(v) * g[0];
+	__int128 cg = static_cast<__int128>(q) * f[0] + static_cast<__int128>(r) * g[0];
+	assert((static_cast<int64_t>(cf) & LIMB62_MASK) == 0 && (static_cast<int64_t>(cg) & LIMB62_MASK) == 0);
+	cf >>= 62;
+	cg >>= 62;
+	for (int i = 1; i < NUM_LIMBS62; i++) {
+		cf += static_cast<__int128>(u) * f[i] + static_cast<__int128>(v) * g[i];
+		cg += static_cast<__int128>(q) * f[i] + static_cast<__int128>(r) * g[i];
+		f[i - 1] = static_cast<int64_t>(cf) & LIMB62_MASK;
+		g[i - 1] = static_cast<int64_t>(cg) & LIMB62_MASK;
+		cf >>= 62;
+		cg >>= 62;
+	}
+	f[NUM_LIMBS62 - 1] = static_cast<int64_t>(cf);
+	g[NUM_LIMBS62 - 1] = static_cast<int64_t>(cg);
+}
+
+
+static void normalize62(int64_t r[NUM_LIMBS62], int64_t sign, const int64_t mod[NUM_LIMBS62]) {
+	// Brings r from the range (-2 * mod, mod) to [0, mod), negating it if sign is negative
+	int64_t condAdd = r[NUM_LIMBS62 - 1] >> 63;
+	int64_t condNegate = sign >> 63;
+	for (int i = 0; i < NUM_LIMBS62; i++) {
+		r[i] += mod[i] & condAdd;
+		r[i] = (r[i] ^ condNegate) - condNegate;
+	}
+	for (int i = 0; i < NUM_LIMBS62 - 1; i++) {
+		r[i + 1] += r[i] >> 62;
+		r[i] &= LIMB62_MASK;
+	}
+	condAdd = r[NUM_LIMBS62 - 1] >> 63;
+	for (int i = 0; i < NUM_LIMBS62; i++)
+		r[i] += mod[i] & condAdd;
+	for (int i = 0; i < NUM_LIMBS62 - 1; i++) {
+		r[i + 1] += r[i] >> 62;
+		r[i] &= LIMB62_MASK;
+	}
+}
+
+
+static void toSigned62(const Uint256 &x, int64_t out[NUM_LIMBS62]) {
+	uint64_t w[Uint256::NUM_WORDS / 2];
+	for (int i = 0; i < Uint256::NUM_WORDS / 2; i++)
+		w[i] = static_cast<uint64_t>(x.value[i * 2 + 1]) << 32 | x.value[i * 2];
+	for (int i = 0; i < NUM_LIMBS62; i++) {
+		int bit = i * 62;
+		uint64_t limb = w[bit >> 6] >> (bit & 63);
+		if ((bit & 63) > 2 && (bit >> 6) + 1 < Uint256::NUM_WORDS / 2)
+			limb |= w[(bit >> 6) + 1] << (64 - (bit & 63));
+		out[i] = static_cast<int64_t>(limb) & LIMB62_MASK;
+	}
+}
+
+
+static void fromSigned62(const int64_t in[NUM_LIMBS62], Uint256 &x) {
+	uint64_t w[Uint256::NUM_WORDS / 2] = {};
+	for (int i = 0; i < NUM_LIMBS62; i++) {
+		assert(0 <= in[i] && in[i] <= LIMB62_MASK);
+		int bit = i * 62;
+		uint64_t limb = static_cast<uint64_t>(in[i]);
+		w[bit >> 6] |= limb << (bit & 63);
+		if ((bit & 63) > 2 && (bit >> 6) + 1 < Uint256::NUM_WORDS / 2)
+			w[(bit >> 6) + 1] |= limb >> (64 - (bit & 63));
+	}
+	for (int i = 0; i < Uint256::NUM_WORDS / 2; i++) {
+		x.value[i * 2 + 0] = static_cast<uint32_t>(w[i]);
+		x.value[i * 2 + 1] = static_cast<uint32_t>(w[i] >> 32);
 	}
-	assert((x == ONE) | (x == modulus));  // Either gcd(this, modulus) = 1 or this = 0
-	this->replace(a, static_cast<uint32_t>(*this != ZERO));
 }
 
 